@@ -5,10 +5,26 @@
  */
 
 #include <LibGC/Cell.h>
+#include <LibGC/Heap.h>
 #include <LibGC/NanBoxedValue.h>
 
 namespace GC {
 
+void Cell::remember_for_young_generation_collection()
+{
+    heap().remember_cell({}, *this);
+}
+
+void Cell::shade_for_incremental_marking(Cell& cell)
+{
+    heap().shade_cell({}, cell);
+}
+
+void Cell::rescan_for_incremental_marking()
+{
+    heap().rescan_cell({}, *this);
+}
+
 void GC::Cell::Visitor::visit(NanBoxedValue const& value)
 {
     if (value.is_cell())
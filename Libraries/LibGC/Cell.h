@@ -47,8 +47,23 @@ public:
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
-    enum class State : bool {
+    // Cells that have survived a garbage collection are "old". Young generation collections only trace
+    // and sweep young cells, and treat old cells as live.
+    bool is_old() const { return m_old; }
+    void set_old(bool b) { m_old = b; }
+
+    bool is_remembered() const { return m_remembered; }
+    void set_remembered(Badge<Heap>, bool b) { m_remembered = b; }
+
+    bool needs_rescan() const { return m_needs_rescan; }
+    void set_needs_rescan(Badge<Heap>, bool b) { m_needs_rescan = b; }
+
+    bool uses_write_barrier() const { return m_uses_write_barrier; }
+
+    enum class State : u8 {
         Live,
+        // Unreachable and finalized, but not destroyed yet. Only used in blocks that are swept lazily.
+        Condemned,
         Dead,
     };
 
@@ -187,8 +202,75 @@ protected:
 
     void set_overrides_must_survive_garbage_collection(bool b) { m_overrides_must_survive_garbage_collection = b; }
 
+    // Cells that promise to call write_barrier() after every store of a GC pointer into themselves (outside of
+    // their constructor) can opt out of being rescanned on every young generation collection, and at the end of
+    // incremental marking. Once enabled, the write barrier can't be turned off again.
+    // NOTE: Cells that don't opt in are treated as if they were always in the remembered set.
+    void enable_write_barrier()
+    {
+        m_uses_write_barrier = true;
+        // Stores that happened before this point weren't tracked.
+        write_barrier_for_unknown_value();
+    }
+
+    ALWAYS_INLINE void write_barrier(Cell const* value)
+    {
+        if (!value)
+            return;
+        if (m_old && !m_remembered && !value->m_old)
+            remember_for_young_generation_collection();
+        // NOTE: Cells are only ever marked while the mutator is running if incremental marking is in progress.
+        //       Storing a white cell into a black one would break the tri-color invariant, so shade it gray.
+        if (m_mark && !value->m_mark)
+            shade_for_incremental_marking(const_cast<Cell&>(*value));
+    }
+
+    // For stores whose value isn't known, e.g. when handing out mutable access to a container of edges.
+    // The whole cell is treated as modified, so the caller must not keep that access across an allocation.
+    ALWAYS_INLINE void write_barrier_for_unknown_value()
+    {
+        if (m_old && !m_remembered)
+            remember_for_young_generation_collection();
+        if (m_mark && !m_needs_rescan)
+            rescan_for_incremental_marking();
+    }
+
+    template<typename T>
+    ALWAYS_INLINE void write_barrier(Ptr<T> value)
+    {
+        write_barrier(value.ptr());
+    }
+
+    template<typename T>
+    ALWAYS_INLINE void write_barrier(Ref<T> value)
+    {
+        write_barrier(value.ptr());
+    }
+
+    template<typename T, typename U>
+    ALWAYS_INLINE void store_edge(Ptr<T>& slot, U* value)
+    {
+        slot = value;
+        write_barrier(slot.ptr());
+    }
+
+    template<typename T, typename U>
+    ALWAYS_INLINE void store_edge(Ref<T>& slot, U& value)
+    {
+        slot = value;
+        write_barrier(slot.ptr());
+    }
+
 private:
+    void remember_for_young_generation_collection();
+    void shade_for_incremental_marking(Cell&);
+    void rescan_for_incremental_marking();
+
     bool m_mark { false };
+    bool m_old { false };
+    bool m_remembered { false };
+    bool m_needs_rescan { false };
+    bool m_uses_write_barrier { false };
     bool m_overrides_must_survive_garbage_collection { false };
     State m_state { State::Live };
 } SWIFT_UNSAFE_REFERENCE;
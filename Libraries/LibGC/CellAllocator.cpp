@@ -12,9 +12,10 @@
 
 namespace GC {
 
-CellAllocator::CellAllocator(size_t cell_size, char const* class_name)
+CellAllocator::CellAllocator(size_t cell_size, char const* class_name, SweepMode sweep_mode)
     : m_class_name(class_name)
     , m_cell_size(cell_size)
+    , m_sweep_mode(sweep_mode)
 {
 }
 
@@ -23,6 +24,9 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
     if (!m_list_node.is_in_list())
         heap.register_cell_allocator({}, *this);
 
+    while (m_usable_blocks.is_empty() && !m_blocks_pending_sweep.is_empty())
+        sweep_pending_block(*m_blocks_pending_sweep.first());
+
     if (m_usable_blocks.is_empty()) {
         auto block = HeapBlock::create_with_cell_size(heap, *this, m_cell_size, m_class_name);
         auto block_ptr = reinterpret_cast<FlatPtr>(block.ptr());
@@ -36,6 +40,10 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
     auto& block = *m_usable_blocks.last();
     auto* cell = block.allocate();
     VERIFY(cell);
+    if (!block.has_young_cells()) {
+        block.set_has_young_cells(true);
+        m_blocks_with_young_cells.append(&block);
+    }
     if (block.is_full())
         m_full_blocks.append(*m_usable_blocks.last());
     return cell;
@@ -43,6 +51,20 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
 
 void CellAllocator::block_did_become_empty(Badge<Heap>, HeapBlock& block)
 {
+    destroy_block(block);
+}
+
+void CellAllocator::clear_blocks_with_young_cells(Badge<Heap>)
+{
+    for (auto* block : m_blocks_with_young_cells)
+        block->set_has_young_cells(false);
+    m_blocks_with_young_cells.clear_with_capacity();
+}
+
+void CellAllocator::destroy_block(HeapBlock& block)
+{
+    if (block.has_young_cells())
+        m_blocks_with_young_cells.remove_first_matching([&](auto* other) { return other == &block; });
     block.m_list_node.remove();
     // NOTE: HeapBlocks are managed by the BlockAllocator, so we don't want to `delete` the block here.
     block.~HeapBlock();
@@ -55,4 +77,37 @@ void CellAllocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
     m_usable_blocks.append(block);
 }
 
+void CellAllocator::block_needs_lazy_sweep(Badge<Heap>, HeapBlock& block)
+{
+    VERIFY(m_sweep_mode == SweepMode::Lazy);
+    m_blocks_pending_sweep.append(block);
+}
+
+void CellAllocator::sweep_all_pending_blocks(Badge<Heap>)
+{
+    while (!m_blocks_pending_sweep.is_empty())
+        sweep_pending_block(*m_blocks_pending_sweep.first());
+}
+
+void CellAllocator::sweep_pending_block(HeapBlock& block)
+{
+    bool block_has_live_cells = false;
+    block.for_each_cell([&](Cell* cell) {
+        if (cell->state() == Cell::State::Condemned)
+            block.deallocate(cell);
+        else if (cell->state() == Cell::State::Live)
+            block_has_live_cells = true;
+    });
+
+    if (!block_has_live_cells) {
+        destroy_block(block);
+        return;
+    }
+
+    if (block.is_full())
+        m_full_blocks.append(block);
+    else
+        m_usable_blocks.append(block);
+}
+
 }
@@ -9,6 +9,7 @@
 #include <AK/IntrusiveList.h>
 #include <AK/NeverDestroyed.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
 #include <LibGC/BlockAllocator.h>
 #include <LibGC/Forward.h>
 #include <LibGC/HeapBlock.h>
@@ -19,14 +20,25 @@
 #define GC_DEFINE_ALLOCATOR(ClassName) \
     GC::TypeIsolatingCellAllocator<ClassName> ClassName::cell_allocator { #ClassName }
 
+// NOTE: Cells from a lazily swept allocator may be destroyed long after they became unreachable, so this must only
+//       be used for types whose destructors don't have observable side effects (e.g. unregistering from caches).
+#define GC_DEFINE_LAZILY_SWEPT_ALLOCATOR(ClassName) \
+    GC::TypeIsolatingCellAllocator<ClassName> ClassName::cell_allocator { #ClassName, GC::CellAllocator::SweepMode::Lazy }
+
 namespace GC {
 
 class CellAllocator {
 public:
-    CellAllocator(size_t cell_size, char const* class_name = nullptr);
+    enum class SweepMode {
+        Eager,
+        Lazy,
+    };
+
+    CellAllocator(size_t cell_size, char const* class_name = nullptr, SweepMode = SweepMode::Eager);
     ~CellAllocator() = default;
 
     size_t cell_size() const { return m_cell_size; }
+    SweepMode sweep_mode() const { return m_sweep_mode; }
 
     Cell* allocate_cell(Heap&);
 
@@ -41,11 +53,32 @@ public:
             if (callback(block) == IterationDecision::Break)
                 return IterationDecision::Break;
         }
+        for (auto& block : m_blocks_pending_sweep) {
+            if (callback(block) == IterationDecision::Break)
+                return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    }
+
+    template<typename Callback>
+    IterationDecision for_each_block_with_young_cells(Callback callback)
+    {
+        for (auto* block : m_blocks_with_young_cells) {
+            if (callback(*block) == IterationDecision::Break)
+                return IterationDecision::Break;
+        }
         return IterationDecision::Continue;
     }
 
+    // Called once every cell that survived a collection has been promoted to the old generation.
+    void clear_blocks_with_young_cells(Badge<Heap>);
+
     void block_did_become_empty(Badge<Heap>, HeapBlock&);
     void block_did_become_usable(Badge<Heap>, HeapBlock&);
+    void block_needs_lazy_sweep(Badge<Heap>, HeapBlock&);
+
+    bool has_blocks_pending_sweep() const { return !m_blocks_pending_sweep.is_empty(); }
+    void sweep_all_pending_blocks(Badge<Heap>);
 
     IntrusiveListNode<CellAllocator> m_list_node;
     using List = IntrusiveList<&CellAllocator::m_list_node>;
@@ -55,14 +88,23 @@ public:
     FlatPtr max_block_address() const { return m_max_block_address; }
 
 private:
+    void sweep_pending_block(HeapBlock&);
+    void destroy_block(HeapBlock&);
+
     char const* const m_class_name { nullptr };
     size_t const m_cell_size;
+    SweepMode const m_sweep_mode { SweepMode::Eager };
 
     BlockAllocator m_block_allocator;
 
     using BlockList = IntrusiveList<&HeapBlock::m_list_node>;
     BlockList m_full_blocks;
     BlockList m_usable_blocks;
+    BlockList m_blocks_pending_sweep;
+
+    // Blocks that had cells allocated in them since the last collection. Young generation collections only need
+    // to look at these (and the remembered set), instead of every block.
+    Vector<HeapBlock*> m_blocks_with_young_cells;
     FlatPtr m_min_block_address { explode_byte(0xff) };
     FlatPtr m_max_block_address { 0 };
 };
@@ -72,8 +114,8 @@ class TypeIsolatingCellAllocator {
 public:
     using CellType = T;
 
-    TypeIsolatingCellAllocator(char const* class_name)
-        : allocator(sizeof(T), class_name)
+    TypeIsolatingCellAllocator(char const* class_name, CellAllocator::SweepMode sweep_mode = CellAllocator::SweepMode::Eager)
+        : allocator(sizeof(T), class_name, sweep_mode)
     {
     }
 
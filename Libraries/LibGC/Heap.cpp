@@ -6,12 +6,14 @@
  */
 
 #include <AK/Badge.h>
+#include <AK/BinarySearch.h>
 #include <AK/Debug.h>
 #include <AK/Function.h>
 #include <AK/HashTable.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/Platform.h>
+#include <AK/QuickSort.h>
 #include <AK/StackInfo.h>
 #include <AK/TemporaryChange.h>
 #include <LibCore/ElapsedTimer.h>
@@ -28,7 +30,7 @@
 
 namespace GC {
 
-Heap::Heap(void* private_data, AK::Function<void(HashMap<Cell*, GC::HeapRoot>&)> gather_embedder_roots)
+Heap::Heap(void* private_data, AK::Function<void(HeapRootSet&)> gather_embedder_roots)
     : HeapBase(private_data)
     , m_gather_embedder_roots(move(gather_embedder_roots))
 {
@@ -50,17 +52,122 @@ Heap::~Heap()
 void Heap::will_allocate(size_t size)
 {
     if (should_collect_on_every_allocation()) {
-        m_allocated_bytes_since_last_gc = 0;
         collect_garbage();
-    } else if (m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold) {
-        m_allocated_bytes_since_last_gc = 0;
+    } else if (m_allocated_bytes_since_last_full_gc + size > m_gc_bytes_threshold) {
         collect_garbage();
+    } else if (m_incremental_marking_enabled && !m_incremental_marking_visitor && !m_gc_deferrals && m_allocated_bytes_since_last_full_gc + size > m_gc_bytes_threshold / 2) {
+        // Get a head start on the next collection, so that most of the marking work can happen in idle slices.
+        start_incremental_marking();
+    } else if (m_generational_collection_enabled && !m_incremental_marking_visitor && m_allocated_bytes_since_last_gc + size > GC_YOUNG_GENERATION_BYTES_THRESHOLD) {
+        collect_garbage(CollectionType::CollectYoungGeneration);
     }
 
     m_allocated_bytes_since_last_gc += size;
+    m_allocated_bytes_since_last_full_gc += size;
 }
 
-static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
+// A sorted list of the addresses of every HeapBlock, used to quickly check whether a possible pointer points into
+// the heap without hashing.
+class HeapBlockIndex {
+public:
+    explicit HeapBlockIndex(Heap& heap)
+    {
+        update(heap);
+    }
+
+    void update(Heap& heap)
+    {
+        m_block_addresses.clear_with_capacity();
+        heap.for_each_block([&](auto& block) {
+            m_block_addresses.append(bit_cast<FlatPtr>(&block));
+            return IterationDecision::Continue;
+        });
+        quick_sort(m_block_addresses);
+
+        if (m_block_addresses.is_empty()) {
+            m_min_block_address = explode_byte(0xff);
+            m_max_block_address = 0;
+        } else {
+            m_min_block_address = m_block_addresses.first();
+            m_max_block_address = m_block_addresses.last() + HeapBlockBase::block_size;
+        }
+    }
+
+    FlatPtr min_block_address() const { return m_min_block_address; }
+    FlatPtr max_block_address() const { return m_max_block_address; }
+
+    HeapBlock* block_containing(FlatPtr address) const
+    {
+        if (address < m_min_block_address || address >= m_max_block_address)
+            return nullptr;
+        auto block_address = address & ~(HeapBlockBase::block_size - 1);
+        if (!binary_search(m_block_addresses, block_address))
+            return nullptr;
+        return bit_cast<HeapBlock*>(block_address);
+    }
+
+private:
+    Vector<FlatPtr> m_block_addresses;
+    FlatPtr m_min_block_address { 0 };
+    FlatPtr m_max_block_address { 0 };
+};
+
+// Values that may or may not be pointers to cells, gathered from the stack, registers and other conservatively
+// scanned memory. Where they came from is only recorded when the heap graph is being dumped.
+class PossiblePointers {
+public:
+    explicit PossiblePointers(bool track_origins)
+        : m_track_origins(track_origins)
+    {
+    }
+
+    bool tracks_origins() const { return m_track_origins; }
+
+    void add(FlatPtr pointer, HeapRoot origin)
+    {
+        m_pointers.append(pointer);
+        if (m_track_origins)
+            m_origins.set(pointer, origin);
+    }
+
+    HeapRoot origin_of(FlatPtr pointer) const
+    {
+        return m_origins.get(pointer).value_or(HeapRoot { .type = HeapRoot::Type::StackPointer });
+    }
+
+    template<typename Callback>
+    void for_each_cell(HeapBlockIndex const& block_index, Callback callback)
+    {
+        quick_sort(m_pointers);
+
+        // NOTE: Since the pointers are sorted, consecutive pointers into the same block only need one lookup.
+        FlatPtr previous_pointer = 0;
+        FlatPtr previous_block_address = 0;
+        HeapBlock* previous_block = nullptr;
+        for (auto possible_pointer : m_pointers) {
+            if (!possible_pointer || possible_pointer == previous_pointer)
+                continue;
+            previous_pointer = possible_pointer;
+
+            auto block_address = possible_pointer & ~(HeapBlockBase::block_size - 1);
+            if (block_address != previous_block_address) {
+                previous_block_address = block_address;
+                previous_block = block_index.block_containing(possible_pointer);
+            }
+            if (!previous_block)
+                continue;
+            if (auto* cell = previous_block->cell_from_possible_pointer(possible_pointer))
+                callback(cell, possible_pointer);
+        }
+    }
+
+private:
+    Vector<FlatPtr> m_pointers;
+    HashMap<FlatPtr, HeapRoot> m_origins;
+    bool m_track_origins { false };
+};
+
+static void add_possible_value(PossiblePointers& possible_pointers, FlatPtr data, HeapRoot origin, HeapBlockIndex const& block_index)
 {
     if constexpr (sizeof(FlatPtr*) == sizeof(NanBoxedValue)) {
         // Because NanBoxedValue stores pointers in non-canonical form we have to check if the top bytes
@@ -71,60 +178,31 @@ static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, Fl
             possible_pointer = NanBoxedValue::extract_pointer_bits(data);
         else
             possible_pointer = data;
-        if (possible_pointer < min_block_address || possible_pointer > max_block_address)
+        if (possible_pointer < block_index.min_block_address() || possible_pointer > block_index.max_block_address())
             return;
-        possible_pointers.set(possible_pointer, move(origin));
+        possible_pointers.add(possible_pointer, move(origin));
     } else {
         static_assert((sizeof(NanBoxedValue) % sizeof(FlatPtr*)) == 0);
-        if (data < min_block_address || data > max_block_address)
+        if (data < block_index.min_block_address() || data > block_index.max_block_address())
             return;
         // In the 32-bit case we will look at the top and bottom part of NanBoxedValue separately we just
         // add both the upper and lower bytes as possible pointers.
-        possible_pointers.set(data, move(origin));
-    }
-}
-
-void Heap::find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address)
-{
-    min_address = explode_byte(0xff);
-    max_address = 0;
-    for (auto& allocator : m_all_cell_allocators) {
-        min_address = min(min_address, allocator.min_block_address());
-        max_address = max(max_address, allocator.max_block_address() + HeapBlockBase::block_size);
-    }
-}
-
-template<typename Callback>
-static void for_each_cell_among_possible_pointers(HashTable<HeapBlock*> const& all_live_heap_blocks, HashMap<FlatPtr, HeapRoot>& possible_pointers, Callback callback)
-{
-    for (auto possible_pointer : possible_pointers.keys()) {
-        if (!possible_pointer)
-            continue;
-        auto* possible_heap_block = HeapBlock::from_cell(reinterpret_cast<Cell const*>(possible_pointer));
-        if (!all_live_heap_blocks.contains(possible_heap_block))
-            continue;
-        if (auto* cell = possible_heap_block->cell_from_possible_pointer(possible_pointer)) {
-            callback(cell, possible_pointer);
-        }
+        possible_pointers.add(data, move(origin));
     }
 }
 
 class GraphConstructorVisitor final : public Cell::Visitor {
 public:
-    explicit GraphConstructorVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    explicit GraphConstructorVisitor(Heap& heap, HeapRootSet const& roots)
         : m_heap(heap)
+        , m_block_index(heap)
     {
-        m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
         m_work_queue.ensure_capacity(roots.size());
 
-        for (auto& [root, root_origin] : roots) {
+        for (auto* root : roots.cells()) {
             auto& graph_node = m_graph.ensure(bit_cast<FlatPtr>(root));
             graph_node.class_name = root->class_name();
-            graph_node.root_origin = root_origin;
+            graph_node.root_origin = roots.origin_of(root);
 
             m_work_queue.append(*root);
         }
@@ -143,13 +221,13 @@ public:
 
     virtual void visit_possible_values(ReadonlyBytes bytes) override
     {
-        HashMap<FlatPtr, HeapRoot> possible_pointers;
+        PossiblePointers possible_pointers(false);
 
         auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
         for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
-            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
+            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_block_index);
 
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+        possible_pointers.for_each_cell(m_block_index, [&](Cell* cell, FlatPtr) {
             if (m_node_being_visited)
                 m_node_being_visited->edges.set(reinterpret_cast<FlatPtr>(cell));
 
@@ -223,14 +301,14 @@ private:
     HashMap<FlatPtr, GraphNode> m_graph;
 
     Heap& m_heap;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
-    FlatPtr m_min_block_address;
-    FlatPtr m_max_block_address;
+    HeapBlockIndex m_block_index;
 };
 
 AK::JsonObject Heap::dump_graph()
 {
-    HashMap<Cell*, HeapRoot> roots;
+    sweep_all_pending_blocks();
+
+    HeapRootSet roots(HeapRootSet::TrackOrigins::Yes);
     gather_roots(roots);
     GraphConstructorVisitor visitor(*this, roots);
     visitor.visit_all_cells();
@@ -248,17 +326,43 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
         if (print_report)
             collection_measurement_timer.start();
 
-        if (collection_type == CollectionType::CollectGarbage) {
+        // Every cell must be either live or dead before we start marking again.
+        sweep_all_pending_blocks();
+
+        // NOTE: Young generation collections need to know every old cell without a write barrier, which is only
+        //       tracked starting with the first full collection after generational collection was enabled.
+        if (collection_type == CollectionType::CollectYoungGeneration && (!m_generational_collection_enabled || !m_tracks_old_cells_without_write_barrier || m_incremental_marking_visitor))
+            collection_type = CollectionType::CollectGarbage;
+
+        // NOTE: However the collection was triggered (allocation, a finished marking slice, or an explicit
+        //       request), the allocation counters start over, so the next one isn't triggered right away.
+        m_allocated_bytes_since_last_gc = 0;
+        if (collection_type != CollectionType::CollectYoungGeneration)
+            m_allocated_bytes_since_last_full_gc = 0;
+
+        if (collection_type != CollectionType::CollectEverything) {
             if (m_gc_deferrals) {
                 m_should_gc_when_deferral_ends = true;
                 return;
             }
-            HashMap<Cell*, HeapRoot> roots;
-            gather_roots(roots);
-            mark_live_cells(roots);
+            if (m_incremental_marking_visitor) {
+                finish_incremental_marking();
+            } else {
+                HeapRootSet roots;
+                gather_roots(roots);
+                mark_live_cells(roots, collection_type);
+            }
+        } else if (m_incremental_marking_visitor) {
+            abort_incremental_marking();
         }
-        finalize_unmarked_cells();
-        sweep_dead_cells(print_report, collection_measurement_timer);
+        AK::Duration marking_time;
+        if (print_report)
+            marking_time = collection_measurement_timer.elapsed_time();
+
+        clear_remembered_set();
+        finalize_unmarked_cells(collection_type);
+        sweep_dead_cells(collection_type, print_report, collection_measurement_timer, marking_time);
+        ++m_collection_count;
     }
 
     auto tasks = move(m_post_gc_tasks);
@@ -271,7 +375,7 @@ void Heap::enqueue_post_gc_task(AK::Function<void()> task)
     m_post_gc_tasks.append(move(task));
 }
 
-void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
+void Heap::gather_roots(HeapRootSet& roots)
 {
     m_gather_embedder_roots(roots);
     gather_conservative_roots(roots);
@@ -285,15 +389,17 @@ void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
     for (auto& hash_map : m_root_hash_maps)
         hash_map.gather_roots(roots);
 
+    roots.sort_and_remove_duplicates();
+
     if constexpr (HEAP_DEBUG) {
         dbgln("gather_roots:");
-        for (auto* root : roots.keys())
+        for (auto* root : roots.cells())
             dbgln("  + {}", root);
     }
 }
 
 #ifdef HAS_ADDRESS_SANITIZER
-NO_SANITIZE_ADDRESS void Heap::gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr addr, FlatPtr min_block_address, FlatPtr max_block_address)
+NO_SANITIZE_ADDRESS void Heap::gather_asan_fake_stack_roots(PossiblePointers& possible_pointers, FlatPtr addr, HeapBlockIndex const& block_index)
 {
     void* begin = nullptr;
     void* end = nullptr;
@@ -304,17 +410,17 @@ NO_SANITIZE_ADDRESS void Heap::gather_asan_fake_stack_roots(HashMap<FlatPtr, Hea
             void const* real_address = *real_stack_addr;
             if (real_address == nullptr)
                 continue;
-            add_possible_value(possible_pointers, reinterpret_cast<FlatPtr>(real_address), HeapRoot { .type = HeapRoot::Type::StackPointer }, min_block_address, max_block_address);
+            add_possible_value(possible_pointers, reinterpret_cast<FlatPtr>(real_address), HeapRoot { .type = HeapRoot::Type::StackPointer }, block_index);
         }
     }
 }
 #else
-void Heap::gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr, FlatPtr)
+void Heap::gather_asan_fake_stack_roots(PossiblePointers&, FlatPtr, HeapBlockIndex const&)
 {
 }
 #endif
 
-NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot>& roots)
+NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HeapRootSet& roots)
 {
     FlatPtr dummy;
 
@@ -323,40 +429,33 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
     jmp_buf buf;
     setjmp(buf);
 
-    HashMap<FlatPtr, HeapRoot> possible_pointers;
+    PossiblePointers possible_pointers(roots.tracks_origins());
 
     auto* raw_jmp_buf = reinterpret_cast<FlatPtr const*>(buf);
 
-    FlatPtr min_block_address, max_block_address;
-    find_min_and_max_block_addresses(min_block_address, max_block_address);
+    HeapBlockIndex block_index(*this);
 
     for (size_t i = 0; i < ((size_t)sizeof(buf)) / sizeof(FlatPtr); ++i)
-        add_possible_value(possible_pointers, raw_jmp_buf[i], HeapRoot { .type = HeapRoot::Type::RegisterPointer }, min_block_address, max_block_address);
+        add_possible_value(possible_pointers, raw_jmp_buf[i], HeapRoot { .type = HeapRoot::Type::RegisterPointer }, block_index);
 
     auto stack_reference = bit_cast<FlatPtr>(&dummy);
 
     for (FlatPtr stack_address = stack_reference; stack_address < m_stack_info.top(); stack_address += sizeof(FlatPtr)) {
         auto data = *reinterpret_cast<FlatPtr*>(stack_address);
-        add_possible_value(possible_pointers, data, HeapRoot { .type = HeapRoot::Type::StackPointer }, min_block_address, max_block_address);
-        gather_asan_fake_stack_roots(possible_pointers, data, min_block_address, max_block_address);
+        add_possible_value(possible_pointers, data, HeapRoot { .type = HeapRoot::Type::StackPointer }, block_index);
+        gather_asan_fake_stack_roots(possible_pointers, data, block_index);
     }
 
     for (auto& vector : m_conservative_vectors) {
         for (auto possible_value : vector.possible_values()) {
-            add_possible_value(possible_pointers, possible_value, HeapRoot { .type = HeapRoot::Type::ConservativeVector }, min_block_address, max_block_address);
+            add_possible_value(possible_pointers, possible_value, HeapRoot { .type = HeapRoot::Type::ConservativeVector }, block_index);
         }
     }
 
-    HashTable<HeapBlock*> all_live_heap_blocks;
-    for_each_block([&](auto& block) {
-        all_live_heap_blocks.set(&block);
-        return IterationDecision::Continue;
-    });
-
-    for_each_cell_among_possible_pointers(all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr possible_pointer) {
+    possible_pointers.for_each_cell(block_index, [&](Cell* cell, FlatPtr possible_pointer) {
         if (cell->state() == Cell::State::Live) {
             dbgln_if(HEAP_DEBUG, "  ?-> {}", (void const*)cell);
-            roots.set(cell, *possible_pointers.get(possible_pointer));
+            roots.set(cell, possible_pointers.origin_of(possible_pointer));
         } else {
             dbgln_if(HEAP_DEBUG, "  #-> {}", (void const*)cell);
         }
@@ -365,16 +464,22 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    explicit MarkingVisitor(Heap& heap, HeapRootSet const& roots, Heap::CollectionType collection_type)
         : m_heap(heap)
+        , m_young_generation_only(collection_type == Heap::CollectionType::CollectYoungGeneration)
+        , m_block_index(heap)
     {
-        m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
+        visit_roots(roots);
+    }
 
-        for (auto* root : roots.keys()) {
+    void update_heap_block_addresses()
+    {
+        m_block_index.update(m_heap);
+    }
+
+    void visit_roots(HeapRootSet const& roots)
+    {
+        for (auto* root : roots.cells()) {
             visit(root);
         }
     }
@@ -383,6 +488,8 @@ public:
     {
         if (cell.is_marked())
             return;
+        if (m_young_generation_only && cell.is_old())
+            return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
 
         cell.set_marked(true);
@@ -391,17 +498,19 @@ public:
 
     virtual void visit_possible_values(ReadonlyBytes bytes) override
     {
-        HashMap<FlatPtr, HeapRoot> possible_pointers;
+        PossiblePointers possible_pointers(false);
 
         auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
         for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
-            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
+            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_block_index);
 
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+        possible_pointers.for_each_cell(m_block_index, [&](Cell* cell, FlatPtr) {
             if (cell->is_marked())
                 return;
             if (cell->state() != Cell::State::Live)
                 return;
+            if (m_young_generation_only && cell->is_old())
+                return;
             cell->set_marked(true);
             m_work_queue.append(*cell);
         });
@@ -414,28 +523,67 @@ public:
         }
     }
 
+    // Returns true if there is no marking work left.
+    bool mark_live_cells_with_budget(Core::ElapsedTimer const& timer, AK::Duration budget)
+    {
+        // NOTE: Reading the clock is not free, so only check it after visiting a batch of cells.
+        static constexpr size_t cells_between_deadline_checks = 64;
+
+        size_t visited_cells = 0;
+        while (!m_work_queue.is_empty()) {
+            auto cell = m_work_queue.take_last();
+            cell->visit_edges(*this);
+            // NOTE: The mutator may store white cells into this one before marking finishes without telling us.
+            if (!cell->uses_write_barrier())
+                m_blackened_cells_without_write_barrier.append(cell);
+            if (++visited_cells % cells_between_deadline_checks == 0 && timer.elapsed_time() >= budget)
+                return false;
+        }
+        return true;
+    }
+
+    Vector<Ref<Cell>> take_blackened_cells_without_write_barrier() { return move(m_blackened_cells_without_write_barrier); }
+
 private:
     Heap& m_heap;
+    bool m_young_generation_only { false };
     Vector<Ref<Cell>> m_work_queue;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
-    FlatPtr m_min_block_address;
-    FlatPtr m_max_block_address;
+    Vector<Ref<Cell>> m_blackened_cells_without_write_barrier;
+    HeapBlockIndex m_block_index;
 };
 
-void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
+void Heap::mark_live_cells(HeapRootSet const& roots, CollectionType collection_type)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
-    MarkingVisitor visitor(*this, roots);
+    MarkingVisitor visitor(*this, roots, collection_type);
+
+    if (collection_type == CollectionType::CollectYoungGeneration) {
+        // Old cells are not traced during a young generation collection, so any old-to-young edges must be
+        // discovered here: either through the remembered set, or by rescanning old cells that don't use
+        // write barriers.
+        for (auto& cell : m_remembered_cells)
+            cell->visit_edges(visitor);
+
+        for (auto& cell : m_old_cells_without_write_barrier) {
+            if (!cell->is_remembered())
+                cell->visit_edges(visitor);
+        }
+    }
 
     visitor.mark_all_live_cells();
 
+    mark_cells_that_must_survive(visitor, collection_type);
+}
+
+void Heap::mark_cells_that_must_survive(MarkingVisitor& visitor, CollectionType collection_type)
+{
     for (auto& inverse_root : m_uprooted_cells)
         inverse_root->set_marked(false);
 
-    for_each_block([&](auto& block) {
+    for_each_block_in_collection(collection_type, [&](auto& block) {
         block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
-            if (!cell->is_marked() && cell_must_survive_garbage_collection(*cell))
+            if (is_cell_condemned(*cell, collection_type) && cell_must_survive_garbage_collection(*cell))
                 cell->visit_edges(visitor);
         });
         return IterationDecision::Continue;
@@ -444,6 +592,97 @@ void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
     m_uprooted_cells.clear();
 }
 
+void Heap::start_incremental_marking()
+{
+    VERIFY(!m_incremental_marking_visitor);
+    VERIFY(!m_collecting_garbage);
+    dbgln_if(HEAP_DEBUG, "start_incremental_marking:");
+
+    sweep_all_pending_blocks();
+
+    HeapRootSet roots;
+    gather_roots(roots);
+    m_incremental_marking_visitor = make<MarkingVisitor>(*this, roots, CollectionType::CollectGarbage);
+}
+
+void Heap::perform_incremental_marking_slice(AK::Duration time_available)
+{
+    if (!m_incremental_marking_visitor || m_collecting_garbage)
+        return;
+
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    auto budget = min(time_available, m_incremental_marking_slice_budget);
+    if (!m_incremental_marking_visitor->mark_live_cells_with_budget(timer, budget))
+        return;
+
+    // All cells reachable from the original roots have been marked, so finish the collection while we're still idle.
+    if (!m_gc_deferrals)
+        collect_garbage();
+}
+
+void Heap::finish_incremental_marking()
+{
+    dbgln_if(HEAP_DEBUG, "finish_incremental_marking:");
+
+    auto visitor = m_incremental_marking_visitor.release_nonnull();
+
+    // Blocks may have been allocated since marking started.
+    visitor->update_heap_block_addresses();
+
+    // The roots may have changed while the mutator was running.
+    HeapRootSet roots;
+    gather_roots(roots);
+    visitor->visit_roots(roots);
+
+    // Cells that don't use write barriers may have had white cells stored into them after they were blackened.
+    // Only the cells blackened by marking slices need another look, since the mutator hasn't run since.
+    for (auto& cell : visitor->take_blackened_cells_without_write_barrier()) {
+        if (!cell->uses_write_barrier())
+            cell->visit_edges(*visitor);
+    }
+
+    for (auto& cell : m_cells_to_rescan) {
+        cell->set_needs_rescan({}, false);
+        if (cell->uses_write_barrier())
+            cell->visit_edges(*visitor);
+    }
+    m_cells_to_rescan.clear();
+
+    visitor->mark_all_live_cells();
+
+    mark_cells_that_must_survive(*visitor, CollectionType::CollectGarbage);
+}
+
+void Heap::abort_incremental_marking()
+{
+    dbgln_if(HEAP_DEBUG, "abort_incremental_marking:");
+
+    m_incremental_marking_visitor = nullptr;
+    for (auto& cell : m_cells_to_rescan)
+        cell->set_needs_rescan({}, false);
+    m_cells_to_rescan.clear();
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            cell->set_marked(false);
+        });
+        return IterationDecision::Continue;
+    });
+}
+
+void Heap::shade_cell(Badge<Cell>, Cell& cell)
+{
+    if (m_incremental_marking_visitor && cell.state() == Cell::State::Live)
+        m_incremental_marking_visitor->visit(cell);
+}
+
+void Heap::rescan_cell(Badge<Cell>, Cell& cell)
+{
+    if (!m_incremental_marking_visitor || cell.needs_rescan())
+        return;
+    cell.set_needs_rescan({}, true);
+    m_cells_to_rescan.append(cell);
+}
+
 bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
 {
     if (!cell.overrides_must_survive_garbage_collection({}))
@@ -451,18 +690,35 @@ bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
     return cell.must_survive_garbage_collection();
 }
 
-void Heap::finalize_unmarked_cells()
+void Heap::clear_remembered_set()
 {
-    for_each_block([&](auto& block) {
-        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
-            if (!cell->is_marked())
+    // NOTE: Every cell that survives a collection is promoted to the old generation, so there can be no
+    //       old-to-young edges left once we're done.
+    for (auto& cell : m_remembered_cells)
+        cell->set_remembered({}, false);
+    m_remembered_cells.clear();
+}
+
+void Heap::finalize_unmarked_cells(CollectionType collection_type)
+{
+    for_each_block_in_collection(collection_type, [&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (is_cell_condemned(*cell, collection_type))
                 cell->finalize();
         });
         return IterationDecision::Continue;
     });
 }
 
-void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+void Heap::sweep_all_pending_blocks()
+{
+    for (auto& allocator : m_all_cell_allocators) {
+        if (allocator.has_blocks_pending_sweep())
+            allocator.sweep_all_pending_blocks({});
+    }
+}
+
+void Heap::sweep_dead_cells(CollectionType collection_type, bool print_report, Core::ElapsedTimer const& measurement_timer, AK::Duration marking_time)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
     Vector<HeapBlock*, 32> empty_blocks;
@@ -473,29 +729,54 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
     size_t collected_cell_bytes = 0;
     size_t live_cell_bytes = 0;
 
-    for_each_block([&](auto& block) {
+    Vector<HeapBlock*, 32> blocks_pending_sweep;
+
+    if (collection_type != CollectionType::CollectYoungGeneration) {
+        m_old_cells_without_write_barrier.clear_with_capacity();
+        m_tracks_old_cells_without_write_barrier = m_generational_collection_enabled;
+    }
+
+    for_each_block_in_collection(collection_type, [&](auto& block) {
         bool block_has_live_cells = false;
+        bool block_has_condemned_cells = false;
         bool block_was_full = block.is_full();
+        // NOTE: Collecting everything happens when the heap is going away, so nobody would ever sweep the pending blocks.
+        bool sweep_lazily = collection_type != CollectionType::CollectEverything && block.cell_allocator().sweep_mode() == CellAllocator::SweepMode::Lazy;
         block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
-            if (!cell->is_marked()) {
+            if (is_cell_condemned(*cell, collection_type)) {
                 dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                block.deallocate(cell);
+                if (sweep_lazily) {
+                    // NOTE: The cell will be destroyed when its allocator needs the space, or before the next collection.
+                    cell->set_state(Cell::State::Condemned);
+                    block_has_condemned_cells = true;
+                } else {
+                    block.deallocate(cell);
+                }
                 ++collected_cells;
                 collected_cell_bytes += block.cell_size();
             } else {
                 cell->set_marked(false);
+                if (m_tracks_old_cells_without_write_barrier && !cell->uses_write_barrier() && (!cell->is_old() || collection_type != CollectionType::CollectYoungGeneration))
+                    m_old_cells_without_write_barrier.append(*cell);
+                cell->set_old(true);
                 block_has_live_cells = true;
                 ++live_cells;
                 live_cell_bytes += block.cell_size();
             }
         });
-        if (!block_has_live_cells)
+        if (block_has_condemned_cells)
+            blocks_pending_sweep.append(&block);
+        else if (!block_has_live_cells)
             empty_blocks.append(&block);
         else if (block_was_full != block.is_full())
             full_blocks_that_became_usable.append(&block);
         return IterationDecision::Continue;
     });
 
+    // Every cell that survived has been promoted, so no block holds young cells anymore.
+    for (auto& allocator : m_all_cell_allocators)
+        allocator.clear_blocks_with_young_cells({});
+
     for (auto& weak_container : m_weak_containers)
         weak_container.remove_dead_cells({});
 
@@ -509,6 +790,11 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         block->cell_allocator().block_did_become_usable({}, *block);
     }
 
+    for (auto* block : blocks_pending_sweep) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock pending lazy sweep @ {}: cell_size={}", block, block->cell_size());
+        block->cell_allocator().block_needs_lazy_sweep({}, *block);
+    }
+
     if constexpr (HEAP_DEBUG) {
         for_each_block([&](auto& block) {
             dbgln(" > Live HeapBlock @ {}: cell_size={}", &block, block.cell_size());
@@ -516,10 +802,14 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         });
     }
 
-    m_gc_bytes_threshold = live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
+    // NOTE: After a young generation collection, the live cell count includes old cells that may have died since
+    //       the last full collection, so only full collections get to adjust the threshold.
+    if (collection_type != CollectionType::CollectYoungGeneration)
+        m_gc_bytes_threshold = live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
 
     if (print_report) {
         AK::Duration const time_spent = measurement_timer.elapsed_time();
+        AK::Duration const sweep_time = time_spent - marking_time;
         size_t live_block_count = 0;
         for_each_block([&](auto&) {
             ++live_block_count;
@@ -528,11 +818,15 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
 
         dbgln("Garbage collection report");
         dbgln("=============================================");
+        dbgln("Collection type: {}", collection_type == CollectionType::CollectYoungGeneration ? "Young generation"sv : "Full"sv);
         dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
+        dbgln("   Marking time: {} ms", marking_time.to_milliseconds());
+        dbgln("  Sweeping time: {} ms", sweep_time.to_milliseconds());
         dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
         dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
+        dbgln(" Pending blocks: {} (swept lazily)", blocks_pending_sweep.size());
         dbgln("=============================================");
     }
 }
@@ -12,8 +12,10 @@
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
 #include <AK/StackInfo.h>
 #include <AK/Swift.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -22,6 +24,7 @@
 #include <LibGC/ConservativeVector.h>
 #include <LibGC/Forward.h>
 #include <LibGC/HeapRoot.h>
+#include <LibGC/HeapRootSet.h>
 #include <LibGC/Internals.h>
 #include <LibGC/Root.h>
 #include <LibGC/RootHashMap.h>
@@ -30,12 +33,16 @@
 
 namespace GC {
 
+class HeapBlockIndex;
+class MarkingVisitor;
+class PossiblePointers;
+
 class Heap : public HeapBase {
     AK_MAKE_NONCOPYABLE(Heap);
     AK_MAKE_NONMOVABLE(Heap);
 
 public:
-    explicit Heap(void* private_data, AK::Function<void(HashMap<Cell*, GC::HeapRoot>&)> gather_embedder_roots);
+    explicit Heap(void* private_data, AK::Function<void(HeapRootSet&)> gather_embedder_roots);
     ~Heap();
 
     template<typename T, typename... Args>
@@ -50,6 +57,7 @@ public:
 
     enum class CollectionType {
         CollectGarbage,
+        CollectYoungGeneration,
         CollectEverything,
     };
 
@@ -59,6 +67,28 @@ public:
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    bool is_generational_collection_enabled() const { return m_generational_collection_enabled; }
+    void set_generational_collection_enabled(bool b)
+    {
+        m_generational_collection_enabled = b;
+        if (!b) {
+            m_tracks_old_cells_without_write_barrier = false;
+            m_old_cells_without_write_barrier.clear();
+        }
+    }
+
+    bool is_incremental_marking_enabled() const { return m_incremental_marking_enabled; }
+    void set_incremental_marking_enabled(bool b) { m_incremental_marking_enabled = b; }
+
+    AK::Duration incremental_marking_slice_budget() const { return m_incremental_marking_slice_budget; }
+    void set_incremental_marking_slice_budget(AK::Duration budget) { m_incremental_marking_slice_budget = budget; }
+
+    bool is_incremental_marking_in_progress() const { return m_incremental_marking_visitor; }
+
+    // Performs a bounded amount of marking work, taking no longer than the slice budget or the given time,
+    // whichever is shorter. Once marking is complete, the collection is finished right away.
+    void perform_incremental_marking_slice(AK::Duration time_available);
+
     void did_create_root(Badge<RootImpl>, RootImpl&);
     void did_destroy_root(Badge<RootImpl>, RootImpl&);
 
@@ -76,13 +106,21 @@ public:
 
     void register_cell_allocator(Badge<CellAllocator>, CellAllocator&);
 
+    void remember_cell(Badge<Cell>, Cell&);
+    void shade_cell(Badge<Cell>, Cell&);
+    void rescan_cell(Badge<Cell>, Cell&);
+
     void uproot_cell(Cell* cell);
 
     bool is_gc_deferred() const { return m_gc_deferrals > 0; }
 
+    // Incremented by every collection. If it hasn't changed, no cell has been freed (and had its address reused).
+    u64 collection_count() const { return m_collection_count; }
+
     void enqueue_post_gc_task(AK::Function<void()>);
 
 private:
+    friend class HeapBlockIndex;
     friend class MarkingVisitor;
     friend class GraphConstructorVisitor;
     friend class DeferGC;
@@ -107,13 +145,25 @@ private:
 
     void will_allocate(size_t);
 
-    void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
-    void gather_roots(HashMap<Cell*, HeapRoot>&);
-    void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
-    void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
-    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
-    void finalize_unmarked_cells();
-    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+    void gather_roots(HeapRootSet&);
+    void gather_conservative_roots(HeapRootSet&);
+    void gather_asan_fake_stack_roots(PossiblePointers&, FlatPtr, HeapBlockIndex const&);
+    void mark_live_cells(HeapRootSet const& live_cells, CollectionType);
+    void mark_cells_that_must_survive(MarkingVisitor&, CollectionType);
+    void start_incremental_marking();
+    void finish_incremental_marking();
+    void abort_incremental_marking();
+    void finalize_unmarked_cells(CollectionType);
+    void sweep_dead_cells(CollectionType, bool print_report, Core::ElapsedTimer const&, AK::Duration marking_time);
+    void sweep_all_pending_blocks();
+    void clear_remembered_set();
+
+    static bool is_cell_condemned(Cell const& cell, CollectionType collection_type)
+    {
+        if (cell.is_marked())
+            return false;
+        return collection_type != CollectionType::CollectYoungGeneration || !cell.is_old();
+    }
 
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
     {
@@ -135,11 +185,33 @@ private:
         }
     }
 
+    // Young generation collections only need to look at blocks that had cells allocated in them since the last
+    // collection, since every other cell is old.
+    template<typename Callback>
+    void for_each_block_in_collection(CollectionType collection_type, Callback callback)
+    {
+        if (collection_type != CollectionType::CollectYoungGeneration) {
+            for_each_block(move(callback));
+            return;
+        }
+        for (auto& allocator : m_all_cell_allocators) {
+            if (allocator.for_each_block_with_young_cells(callback) == IterationDecision::Break)
+                return;
+        }
+    }
+
     static constexpr size_t GC_MIN_BYTES_THRESHOLD { 4 * 1024 * 1024 };
+    static constexpr size_t GC_YOUNG_GENERATION_BYTES_THRESHOLD { 1 * 1024 * 1024 };
     size_t m_gc_bytes_threshold { GC_MIN_BYTES_THRESHOLD };
     size_t m_allocated_bytes_since_last_gc { 0 };
+    size_t m_allocated_bytes_since_last_full_gc { 0 };
 
     bool m_should_collect_on_every_allocation { false };
+    bool m_generational_collection_enabled { false };
+    bool m_incremental_marking_enabled { false };
+
+    AK::Duration m_incremental_marking_slice_budget { AK::Duration::from_milliseconds(5) };
+    OwnPtr<MarkingVisitor> m_incremental_marking_visitor;
 
     Vector<NonnullOwnPtr<CellAllocator>> m_size_based_cell_allocators;
     CellAllocator::List m_all_cell_allocators;
@@ -152,12 +224,24 @@ private:
 
     Vector<Ptr<Cell>> m_uprooted_cells;
 
+    // Old cells that had a pointer to a young cell stored into them since the last collection.
+    Vector<Ref<Cell>> m_remembered_cells;
+
+    // Old cells that don't use write barriers, which must be rescanned on every young generation collection.
+    // NOTE: Old cells only die in full collections, which rebuild this list from scratch.
+    Vector<Ref<Cell>> m_old_cells_without_write_barrier;
+    bool m_tracks_old_cells_without_write_barrier { false };
+
+    // Black cells that had an unknown value stored into them during incremental marking.
+    Vector<Ref<Cell>> m_cells_to_rescan;
+
     size_t m_gc_deferrals { 0 };
+    u64 m_collection_count { 0 };
     bool m_should_gc_when_deferral_ends { false };
 
     bool m_collecting_garbage { false };
     StackInfo m_stack_info;
-    AK::Function<void(HashMap<Cell*, GC::HeapRoot>&)> m_gather_embedder_roots;
+    AK::Function<void(HeapRootSet&)> m_gather_embedder_roots;
 
     Vector<AK::Function<void()>> m_post_gc_tasks;
 } SWIFT_IMMORTAL_REFERENCE;
@@ -227,4 +311,12 @@ inline void Heap::register_cell_allocator(Badge<CellAllocator>, CellAllocator& a
     m_all_cell_allocators.append(allocator);
 }
 
+inline void Heap::remember_cell(Badge<Cell>, Cell& cell)
+{
+    VERIFY(cell.is_old());
+    VERIFY(!cell.is_remembered());
+    cell.set_remembered({}, true);
+    m_remembered_cells.append(cell);
+}
+
 }
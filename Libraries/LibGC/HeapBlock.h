@@ -92,6 +92,10 @@ public:
 
     CellAllocator& cell_allocator() { return m_cell_allocator; }
 
+    // Whether a cell was allocated in this block since the last collection, i.e. it may contain young cells.
+    bool has_young_cells() const { return m_has_young_cells; }
+    void set_has_young_cells(bool b) { m_has_young_cells = b; }
+
 private:
     HeapBlock(Heap&, CellAllocator&, size_t cell_size);
 
@@ -112,6 +116,7 @@ private:
     size_t m_cell_size { 0 };
     size_t m_next_lazy_freelist_index { 0 };
     Ptr<FreelistEntry> m_freelist;
+    bool m_has_young_cells { false };
     alignas(__BIGGEST_ALIGNMENT__) u8 m_storage[];
 
 public:
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/QuickSort.h>
+#include <AK/Vector.h>
+#include <LibGC/Forward.h>
+#include <LibGC/HeapRoot.h>
+
+namespace GC {
+
+// A flat list of root cells gathered at the start of a collection.
+// Knowing where each root came from is only interesting when dumping the heap graph, so origins are
+// only recorded if asked for; otherwise gathering roots is just a series of appends.
+class HeapRootSet {
+    AK_MAKE_NONCOPYABLE(HeapRootSet);
+    AK_MAKE_NONMOVABLE(HeapRootSet);
+
+public:
+    enum class TrackOrigins {
+        No,
+        Yes,
+    };
+
+    explicit HeapRootSet(TrackOrigins track_origins = TrackOrigins::No)
+        : m_track_origins(track_origins == TrackOrigins::Yes)
+    {
+    }
+
+    bool tracks_origins() const { return m_track_origins; }
+
+    ALWAYS_INLINE void set(Cell* cell, HeapRoot origin)
+    {
+        if (!cell)
+            return;
+        m_cells.append(cell);
+        if (m_track_origins)
+            m_origins.set(cell, origin);
+    }
+
+    // Sorts the roots by address and drops duplicates, so each root is visited exactly once and in memory order.
+    void sort_and_remove_duplicates()
+    {
+        if (m_cells.size() < 2)
+            return;
+        quick_sort(m_cells);
+        size_t unique_count = 1;
+        for (size_t i = 1; i < m_cells.size(); ++i) {
+            if (m_cells[i] != m_cells[unique_count - 1])
+                m_cells[unique_count++] = m_cells[i];
+        }
+        m_cells.shrink(unique_count, true);
+    }
+
+    ReadonlySpan<Cell*> cells() const { return m_cells; }
+    size_t size() const { return m_cells.size(); }
+
+    Optional<HeapRoot> origin_of(Cell* cell) const
+    {
+        return m_origins.get(cell);
+    }
+
+private:
+    Vector<Cell*> m_cells;
+    HashMap<Cell*, HeapRoot> m_origins;
+    bool m_track_origins { false };
+};
+
+}
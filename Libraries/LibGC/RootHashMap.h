@@ -11,13 +11,13 @@
 #include <AK/Vector.h>
 #include <LibGC/Cell.h>
 #include <LibGC/Forward.h>
-#include <LibGC/HeapRoot.h>
+#include <LibGC/HeapRootSet.h>
 
 namespace GC {
 
 class RootHashMapBase {
 public:
-    virtual void gather_roots(HashMap<Cell*, GC::HeapRoot>&) const = 0;
+    virtual void gather_roots(HeapRootSet&) const = 0;
 
 protected:
     explicit RootHashMapBase(Heap&);
@@ -47,7 +47,7 @@ public:
 
     virtual ~RootHashMap() = default;
 
-    virtual void gather_roots(HashMap<Cell*, GC::HeapRoot>& roots) const override
+    virtual void gather_roots(HeapRootSet& roots) const override
     {
         for (auto& [key, value] : *this) {
             if constexpr (IsBaseOf<NanBoxedValue, V>) {
@@ -12,13 +12,13 @@
 #include <AK/Vector.h>
 #include <LibGC/Cell.h>
 #include <LibGC/Forward.h>
-#include <LibGC/HeapRoot.h>
+#include <LibGC/HeapRootSet.h>
 
 namespace GC {
 
 class RootVectorBase {
 public:
-    virtual void gather_roots(HashMap<Cell*, GC::HeapRoot>&) const = 0;
+    virtual void gather_roots(HeapRootSet&) const = 0;
 
 protected:
     explicit RootVectorBase(Heap&);
@@ -83,7 +83,7 @@ public:
         return *this;
     }
 
-    virtual void gather_roots(HashMap<Cell*, GC::HeapRoot>& roots) const override
+    virtual void gather_roots(HeapRootSet& roots) const override
     {
         for (auto& value : *this) {
             if constexpr (IsBaseOf<NanBoxedValue, T>) {
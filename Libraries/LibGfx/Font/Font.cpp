@@ -11,6 +11,7 @@
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Font/TypefaceSkia.h>
 #include <LibGfx/TextLayout.h>
+#include <LibGfx/TextShapingCache.h>
 
 #include <core/SkFont.h>
 #include <core/SkFontMetrics.h>
@@ -129,6 +130,51 @@ hb_font_t* Font::harfbuzz_font() const
     return m_harfbuzz_font;
 }
 
+Font::PrintableAsciiGlyphs const* Font::printable_ascii_glyphs_for_simple_shaping() const
+{
+    if (m_did_look_up_printable_ascii_glyphs)
+        return m_printable_ascii_glyphs.ptr();
+    m_did_look_up_printable_ascii_glyphs = true;
+
+    // Any of these tables may substitute, reorder or reposition glyphs, which is up to HarfBuzz.
+    static constexpr Array shaping_table_tags {
+        HB_TAG('G', 'S', 'U', 'B'),
+        HB_TAG('G', 'P', 'O', 'S'),
+        HB_TAG('k', 'e', 'r', 'n'),
+        HB_TAG('m', 'o', 'r', 't'),
+        HB_TAG('m', 'o', 'r', 'x'),
+        HB_TAG('k', 'e', 'r', 'x'),
+        HB_TAG('t', 'r', 'a', 'k'),
+    };
+    auto* face = typeface().harfbuzz_typeface();
+    for (auto tag : shaping_table_tags) {
+        auto* blob = hb_face_reference_table(face, tag);
+        auto length = hb_blob_get_length(blob);
+        hb_blob_destroy(blob);
+        if (length > 0)
+            return nullptr;
+    }
+
+    auto glyphs = make<PrintableAsciiGlyphs>();
+    auto* hb_font = harfbuzz_font();
+    for (u32 code_point = first_printable_ascii_code_point; code_point <= last_printable_ascii_code_point; ++code_point) {
+        // NOTE: Missing glyphs are shaped as glyph 0 (.notdef), just like HarfBuzz does.
+        hb_codepoint_t glyph_id = 0;
+        if (!hb_font_get_nominal_glyph(hb_font, code_point, &glyph_id))
+            glyph_id = 0;
+        (*glyphs)[code_point - first_printable_ascii_code_point] = { glyph_id, hb_font_get_glyph_h_advance(hb_font, glyph_id) };
+    }
+    m_printable_ascii_glyphs = move(glyphs);
+    return m_printable_ascii_glyphs.ptr();
+}
+
+TextShapingCache& Font::shaping_cache() const
+{
+    if (!m_shaping_cache)
+        m_shaping_cache = make<TextShapingCache>();
+    return *m_shaping_cache;
+}
+
 SkFont Font::skia_font(float scale) const
 {
     auto const& sk_typeface = as<TypefaceSkia>(*m_typeface).sk_typeface();
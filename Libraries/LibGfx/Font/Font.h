@@ -9,7 +9,9 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/FlyString.h>
+#include <AK/OwnPtr.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Font/Typeface.h>
 
@@ -18,6 +20,8 @@ struct hb_font_t;
 
 namespace Gfx {
 
+class TextShapingCache;
+
 struct FontPixelMetrics {
     float size { 0 };
     float x_height { 0 };
@@ -82,9 +86,27 @@ public:
     Font const& bold_variant() const;
     hb_font_t* harfbuzz_font() const;
 
+    static constexpr u32 first_printable_ascii_code_point = 0x20;
+    static constexpr u32 last_printable_ascii_code_point = 0x7e;
+
+    struct SimpleGlyph {
+        u32 glyph_id { 0 };
+        i32 advance { 0 };
+    };
+    using PrintableAsciiGlyphs = Array<SimpleGlyph, last_printable_ascii_code_point - first_printable_ascii_code_point + 1>;
+
+    // Returns the glyph and advance (in units of 1/text_shaping_resolution pixels) of every printable ASCII character,
+    // if this font has none of the tables that make shaping more than a lookup of those. Otherwise, returns nullptr.
+    PrintableAsciiGlyphs const* printable_ascii_glyphs_for_simple_shaping() const;
+
+    TextShapingCache& shaping_cache() const;
+
 private:
     mutable RefPtr<Font const> m_bold_variant;
     mutable hb_font_t* m_harfbuzz_font { nullptr };
+    mutable OwnPtr<PrintableAsciiGlyphs> m_printable_ascii_glyphs;
+    mutable bool m_did_look_up_printable_ascii_glyphs { false };
+    mutable OwnPtr<TextShapingCache> m_shaping_cache;
 
     NonnullRefPtr<Typeface const> m_typeface;
     float m_x_scale { 0.0f };
@@ -9,6 +9,7 @@
 #include "TextLayout.h"
 #include <AK/TypeCasts.h>
 #include <LibGfx/Point.h>
+#include <LibGfx/TextShapingCache.h>
 #include <harfbuzz/hb.h>
 
 namespace Gfx {
@@ -52,16 +53,17 @@ Vector<NonnullRefPtr<GlyphRun>> shape_text(FloatPoint baseline_start, Utf8View s
     return runs;
 }
 
-RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spacing, Utf8View string, Gfx::Font const& font, GlyphRun::TextType text_type, ShapeFeatures const& features)
+static u32 tag_to_u32(char const (&tag)[4])
+{
+    return HB_TAG(tag[0], tag[1], tag[2], tag[3]);
+}
+
+static Vector<ShapedGlyph> shape_with_harfbuzz(Utf8View const& string, Font const& font, ShapeFeatures const& features)
 {
     static hb_buffer_t* buffer = hb_buffer_create();
     hb_buffer_add_utf8(buffer, reinterpret_cast<char const*>(string.bytes()), string.byte_length(), 0, -1);
     hb_buffer_guess_segment_properties(buffer);
 
-    u32 glyph_count;
-    auto* glyph_info = hb_buffer_get_glyph_infos(buffer, &glyph_count);
-    Vector<hb_glyph_info_t> const input_glyph_info({ glyph_info, glyph_count });
-
     auto* hb_font = font.harfbuzz_font();
     hb_feature_t const* hb_features_data = nullptr;
     Vector<hb_feature_t> hb_features;
@@ -69,7 +71,7 @@ RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spacing, Utf
         hb_features.ensure_capacity(features.size());
         for (auto const& feature : features) {
             hb_features.append({
-                .tag = HB_TAG(feature.tag[0], feature.tag[1], feature.tag[2], feature.tag[3]),
+                .tag = tag_to_u32(feature.tag),
                 .value = feature.value,
                 .start = 0,
                 .end = HB_FEATURE_GLOBAL_END,
@@ -80,18 +82,61 @@ RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spacing, Utf
 
     hb_shape(hb_font, buffer, hb_features_data, features.size());
 
-    glyph_info = hb_buffer_get_glyph_infos(buffer, &glyph_count);
+    u32 glyph_count;
+    auto* glyph_info = hb_buffer_get_glyph_infos(buffer, &glyph_count);
     auto* positions = hb_buffer_get_glyph_positions(buffer, &glyph_count);
 
+    Vector<ShapedGlyph> glyphs;
+    glyphs.ensure_capacity(glyph_count);
+    for (size_t i = 0; i < glyph_count; ++i)
+        glyphs.unchecked_append({ glyph_info[i].codepoint, positions[i].x_offset, positions[i].y_offset, positions[i].x_advance, positions[i].y_advance });
+
+    hb_buffer_reset(buffer);
+    return glyphs;
+}
+
+static Vector<ShapedGlyph> const& cached_shape_with_harfbuzz(Utf8View const& string, Font const& font, ShapeFeatures const& features)
+{
+    auto& cache = font.shaping_cache();
+    if (auto const* glyphs = cache.get(string.as_string(), features))
+        return *glyphs;
+    return cache.set(string.as_string(), features, shape_with_harfbuzz(string, font, features));
+}
+
+// Shaping printable ASCII text with a font that has no tables that could substitute or reposition glyphs is a matter of
+// looking up each character's glyph and advance, so HarfBuzz isn't needed for it. Features can't do anything either.
+static Optional<Vector<ShapedGlyph>> shape_printable_ascii_text(Utf8View const& string, Font const& font)
+{
+    auto const* ascii_glyphs = font.printable_ascii_glyphs_for_simple_shaping();
+    if (!ascii_glyphs)
+        return {};
+
+    Vector<ShapedGlyph> glyphs;
+    glyphs.ensure_capacity(string.byte_length());
+    for (auto byte : string.as_string().bytes()) {
+        if (byte < Font::first_printable_ascii_code_point || byte > Font::last_printable_ascii_code_point)
+            return {};
+        auto const& glyph = (*ascii_glyphs)[byte - Font::first_printable_ascii_code_point];
+        glyphs.unchecked_append({ .glyph_id = glyph.glyph_id, .x_advance = glyph.advance });
+    }
+    return glyphs;
+}
+
+static NonnullRefPtr<GlyphRun> create_glyph_run(FloatPoint baseline_start, float letter_spacing, Vector<ShapedGlyph> const& shaped_glyphs, Gfx::Font const& font, GlyphRun::TextType text_type)
+{
+    auto glyph_count = shaped_glyphs.size();
+
     Vector<Gfx::DrawGlyph> glyph_run;
+    glyph_run.ensure_capacity(glyph_count);
     FloatPoint point = baseline_start;
     for (size_t i = 0; i < glyph_count; ++i) {
+        auto const& glyph = shaped_glyphs[i];
 
         auto position = point
             - FloatPoint { 0, font.pixel_metrics().ascent }
-            + FloatPoint { positions[i].x_offset, positions[i].y_offset } / text_shaping_resolution;
-        glyph_run.append({ position, glyph_info[i].codepoint });
-        point += FloatPoint { positions[i].x_advance, positions[i].y_advance } / text_shaping_resolution;
+            + FloatPoint { glyph.x_offset, glyph.y_offset } / text_shaping_resolution;
+        glyph_run.unchecked_append({ position, glyph.glyph_id });
+        point += FloatPoint { glyph.x_advance, glyph.y_advance } / text_shaping_resolution;
 
         // don't apply spacing to last glyph
         // https://drafts.csswg.org/css-text/#example-7880704e
@@ -99,9 +144,21 @@ RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spacing, Utf
             point.translate_by(letter_spacing, 0);
     }
 
-    auto run = adopt_ref(*new Gfx::GlyphRun(move(glyph_run), font, text_type, point.x() - baseline_start.x()));
-    hb_buffer_reset(buffer);
-    return run;
+    return adopt_ref(*new Gfx::GlyphRun(move(glyph_run), font, text_type, point.x() - baseline_start.x()));
+}
+
+RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spacing, Utf8View string, Gfx::Font const& font, GlyphRun::TextType text_type, ShapeFeatures const& features)
+{
+    if (auto ascii_glyphs = shape_printable_ascii_text(string, font); ascii_glyphs.has_value())
+        return create_glyph_run(baseline_start, letter_spacing, *ascii_glyphs, font, text_type);
+    if (string.byte_length() <= TextShapingCache::max_text_length)
+        return create_glyph_run(baseline_start, letter_spacing, cached_shape_with_harfbuzz(string, font, features), font, text_type);
+    return create_glyph_run(baseline_start, letter_spacing, shape_with_harfbuzz(string, font, features), font, text_type);
+}
+
+RefPtr<GlyphRun> shape_text_with_harfbuzz(FloatPoint baseline_start, float letter_spacing, Utf8View string, Gfx::Font const& font, GlyphRun::TextType text_type, ShapeFeatures const& features)
+{
+    return create_glyph_run(baseline_start, letter_spacing, shape_with_harfbuzz(string, font, features), font, text_type);
 }
 
 float measure_text_width(Utf8View const& string, Gfx::Font const& font, ShapeFeatures const& features)
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashFunctions.h>
+#include <AK/StringHash.h>
+#include <LibGfx/TextShapingCache.h>
+
+namespace Gfx {
+
+static unsigned hash_key(StringView text, ShapeFeatures const& features)
+{
+    auto hash = text.hash();
+    for (auto const& feature : features)
+        hash = pair_int_hash(hash, pair_int_hash(string_hash(feature.tag, sizeof(feature.tag)), feature.value));
+    return hash;
+}
+
+static bool features_are_equal(ShapeFeatures const& a, ShapeFeatures const& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (StringView { a[i].tag, sizeof(a[i].tag) } != StringView { b[i].tag, sizeof(b[i].tag) } || a[i].value != b[i].value)
+            return false;
+    }
+    return true;
+}
+
+unsigned TextShapingCache::KeyTraits::hash(Key const& key)
+{
+    return hash_key(key.text, key.features);
+}
+
+bool TextShapingCache::KeyTraits::equals(Key const& a, Key const& b)
+{
+    return a.text == b.text && features_are_equal(a.features, b.features);
+}
+
+Vector<ShapedGlyph> const* TextShapingCache::get(StringView text, ShapeFeatures const& features)
+{
+    auto hash = hash_key(text, features);
+    auto matches = [&](auto const& entry) {
+        return entry.key.text == text && features_are_equal(entry.key.features, features);
+    };
+
+    auto it = m_entries.find(hash, matches);
+    if (it == m_entries.end())
+        return nullptr;
+
+    // Re-inserting the entry moves it to the back of the eviction order.
+    auto key = move(it->key);
+    auto glyphs = move(it->value);
+    m_entries.remove(it);
+    m_entries.set(move(key), move(glyphs));
+    return &m_entries.find(hash, matches)->value;
+}
+
+Vector<ShapedGlyph> const& TextShapingCache::set(StringView text, ShapeFeatures const& features, Vector<ShapedGlyph> glyphs)
+{
+    if (m_entries.size() >= max_entry_count)
+        m_entries.remove(m_entries.begin());
+
+    Key key { ByteString(text), features };
+    auto hash = KeyTraits::hash(key);
+    m_entries.set(move(key), move(glyphs));
+    return m_entries.find(hash, [&](auto const& entry) {
+        return entry.key.text == text && features_are_equal(entry.key.features, features);
+    })->value;
+}
+
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/Vector.h>
+#include <LibGfx/TextLayout.h>
+
+namespace Gfx {
+
+// The output of shaping a string, in the units used by HarfBuzz (i.e. 1/text_shaping_resolution pixels).
+struct ShapedGlyph {
+    u32 glyph_id { 0 };
+    i32 x_offset { 0 };
+    i32 y_offset { 0 };
+    i32 x_advance { 0 };
+    i32 y_advance { 0 };
+};
+
+// Layout keeps shaping the same words with the same fonts (e.g. on every relayout after a resize), so each font keeps
+// the results for short strings around. They're owned by the font, and go away along with it.
+class TextShapingCache {
+public:
+    static constexpr size_t max_text_length = 64;
+    static constexpr size_t max_entry_count = 512;
+
+    // Returns the cached glyphs for this text and these features, and marks them as the most recently used.
+    Vector<ShapedGlyph> const* get(StringView text, ShapeFeatures const&);
+
+    // Adds the glyphs for this text and these features, evicting the least recently used entry if the cache is full.
+    Vector<ShapedGlyph> const& set(StringView text, ShapeFeatures const&, Vector<ShapedGlyph>);
+
+    size_t size() const { return m_entries.size(); }
+
+private:
+    struct Key {
+        ByteString text;
+        ShapeFeatures features;
+    };
+
+    struct KeyTraits : public DefaultTraits<Key> {
+        static unsigned hash(Key const&);
+        static bool equals(Key const&, Key const&);
+    };
+
+    OrderedHashMap<Key, Vector<ShapedGlyph>, KeyTraits> m_entries;
+};
+
+}
@@ -16,6 +16,7 @@
 #include <LibGC/ConservativeVector.h>
 #include <LibGC/RootVector.h>
 #include <LibJS/AST.h>
+#include <LibJS/Parser.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -854,6 +855,44 @@ RefPtr<SharedFunctionInstanceData> FunctionNode::shared_data() const
     return m_shared_data;
 }
 
+void FunctionNode::set_lazy_body(NonnullOwnPtr<LazyFunctionBody> lazy_body) const
+{
+    VERIFY(!m_shared_data);
+    m_lazy_body = move(lazy_body);
+    m_body = nullptr;
+}
+
+void FunctionNode::parse_lazy_body_if_needed() const
+{
+    if (!m_lazy_body)
+        return;
+
+    auto body = Parser::parse_lazy_function_body(*this, *m_lazy_body);
+
+    // NOTE: The order of local variables is not guaranteed to match the initial parse, so take them from the new body.
+    m_local_variables_names = body->local_variables_names();
+    m_body = move(body);
+    m_lazy_body = nullptr;
+}
+
+Statement const& FunctionNode::body() const
+{
+    parse_lazy_body_if_needed();
+    return *m_body;
+}
+
+NonnullRefPtr<Statement const> FunctionNode::body_ptr() const
+{
+    parse_lazy_body_if_needed();
+    return *m_body;
+}
+
+Vector<FlyString> const& FunctionNode::local_variables_names() const
+{
+    parse_lazy_body_if_needed();
+    return m_local_variables_names;
+}
+
 void FunctionNode::dump(int indent, ByteString const& class_name) const
 {
     print_indent(indent);
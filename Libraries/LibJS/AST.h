@@ -10,6 +10,7 @@
 
 #include <AK/ByteString.h>
 #include <AK/FlyString.h>
+#include <AK/HashTable.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
 #include <AK/Variant.h>
@@ -43,10 +44,15 @@ class MemberExpression;
 class VariableDeclaration;
 class SharedFunctionInstanceData;
 
+// The memory allocated for AST nodes on this thread so far, which the parser uses to estimate how much memory a
+// Program keeps alive. This doesn't go down when nodes are destroyed, and doesn't include what the nodes point to.
+inline thread_local size_t g_ast_node_memory_allocated = 0;
+
 template<class T, class... Args>
 static inline NonnullRefPtr<T>
 create_ast_node(SourceRange range, Args&&... args)
 {
+    g_ast_node_memory_allocated += sizeof(T);
     return adopt_ref(*new T(move(range), forward<Args>(args)...));
 }
 
@@ -140,6 +146,7 @@ protected:
     {
         static_assert(sizeof(ActualDerived) == sizeof(Derived), "This leaf class cannot add more members");
         static_assert(alignof(ActualDerived) % alignof(T) == 0, "Need padding for tail array");
+        g_ast_node_memory_allocated += sizeof(ActualDerived) + tail_size * sizeof(T);
         auto* memory = ::operator new(sizeof(ActualDerived) + tail_size * sizeof(T));
         return adopt_ref(*::new (memory) ActualDerived(move(source_range), forward<Args>(args)...));
     }
@@ -568,11 +575,16 @@ public:
 
     ThrowCompletionOr<void> global_declaration_instantiation(VM&, GlobalEnvironment&) const;
 
+    // An upper bound for the memory taken up by the nodes of this program's AST, as measured while parsing it.
+    size_t ast_memory_usage() const { return m_ast_memory_usage; }
+    void set_ast_memory_usage(Badge<Parser>, size_t ast_memory_usage) { m_ast_memory_usage = ast_memory_usage; }
+
 private:
     virtual bool is_program() const override { return true; }
 
     bool m_is_strict_mode { false };
     Type m_type { Type::Script };
+    size_t m_ast_memory_usage { 0 };
 
     Vector<NonnullRefPtr<ImportStatement const>> m_imports;
     Vector<NonnullRefPtr<ExportStatement const>> m_exports;
@@ -776,16 +788,27 @@ struct FunctionParsingInsights {
     bool might_need_arguments_object { false };
 };
 
+// Everything needed to parse a function body again after its AST was dropped to save memory.
+struct LazyFunctionBody {
+    NonnullRefPtr<SourceCode const> source_code;
+    Position opening_curly_position;
+    bool is_module { false };
+    bool strict_mode { false };
+
+    // Free identifiers of the body that the parse of the whole program turned into global variable accesses.
+    HashTable<FlyString> global_identifier_names;
+};
+
 class FunctionNode {
 public:
     FlyString name() const { return m_name ? m_name->string() : ""_fly_string; }
     RefPtr<Identifier const> name_identifier() const { return m_name; }
     ByteString const& source_text() const { return m_source_text; }
-    Statement const& body() const { return *m_body; }
-    auto const& body_ptr() const { return m_body; }
+    Statement const& body() const;
+    NonnullRefPtr<Statement const> body_ptr() const;
     auto const& parameters() const { return m_parameters; }
     i32 function_length() const { return m_function_length; }
-    Vector<FlyString> const& local_variables_names() const { return m_local_variables_names; }
+    Vector<FlyString> const& local_variables_names() const;
     bool is_strict_mode() const { return m_is_strict_mode; }
     bool might_need_arguments_object() const { return m_parsing_insights.might_need_arguments_object; }
     bool contains_direct_call_to_eval() const { return m_parsing_insights.contains_direct_call_to_eval; }
@@ -800,6 +823,10 @@ public:
     RefPtr<SharedFunctionInstanceData> shared_data() const;
     void set_shared_data(RefPtr<SharedFunctionInstanceData>) const;
 
+    // Drops the body AST, which is then parsed again from source the next time it is needed.
+    bool has_lazy_body() const { return m_lazy_body; }
+    void set_lazy_body(NonnullOwnPtr<LazyFunctionBody>) const;
+
     virtual ~FunctionNode();
 
 protected:
@@ -809,8 +836,11 @@ protected:
     RefPtr<Identifier const> m_name { nullptr };
 
 private:
+    void parse_lazy_body_if_needed() const;
+
     ByteString m_source_text;
-    NonnullRefPtr<Statement const> m_body;
+    mutable RefPtr<Statement const> m_body;
+    mutable OwnPtr<LazyFunctionBody> m_lazy_body;
     NonnullRefPtr<FunctionParameters const> m_parameters;
     i32 const m_function_length;
     FunctionKind m_kind;
@@ -818,7 +848,7 @@ private:
     bool m_is_arrow_function : 1 { false };
     FunctionParsingInsights m_parsing_insights;
 
-    Vector<FlyString> m_local_variables_names;
+    mutable Vector<FlyString> m_local_variables_names;
 
     mutable RefPtr<SharedFunctionInstanceData> m_shared_data;
 };
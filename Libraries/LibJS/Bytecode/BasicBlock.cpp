@@ -37,4 +37,11 @@ void BasicBlock::grow(size_t additional_size)
     m_buffer.resize(m_buffer.size() + additional_size);
 }
 
+void BasicBlock::replace_instruction_stream(Vector<u8> buffer, HashMap<size_t, SourceRecord> source_map, size_t last_instruction_start_offset)
+{
+    m_buffer = move(buffer);
+    m_source_map = move(source_map);
+    m_last_instruction_start_offset = last_instruction_start_offset;
+}
+
 }
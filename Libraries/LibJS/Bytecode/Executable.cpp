@@ -4,10 +4,13 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashFunctions.h>
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/Value.h>
 #include <LibJS/SourceCode.h>
 
@@ -39,7 +42,87 @@ Executable::Executable(
     global_variable_caches.resize(number_of_global_variable_caches);
 }
 
-Executable::~Executable() = default;
+Executable::~Executable()
+{
+#if JS_BYTECODE_DEBUG
+    if (g_dump_property_lookup_cache_statistics)
+        dump_property_lookup_cache_statistics();
+#endif
+
+    source_code->did_destroy_executable({}, m_memory_usage);
+}
+
+void Executable::did_finish_code_generation(Badge<Generator>)
+{
+    VERIFY(m_memory_usage == 0);
+
+    m_memory_usage = sizeof(Executable)
+        + bytecode.capacity()
+        + property_lookup_caches.capacity() * sizeof(PropertyLookupCache)
+        + global_variable_caches.capacity() * sizeof(GlobalVariableCache)
+        + constants.capacity() * sizeof(Value)
+        + exception_handlers.capacity() * sizeof(ExceptionHandlers)
+        + basic_block_start_offsets.capacity() * sizeof(size_t)
+        + source_map.capacity() * (sizeof(size_t) + sizeof(SourceRecord))
+        + local_variable_names.capacity() * sizeof(FlyString);
+
+    source_code->did_create_executable({}, m_memory_usage);
+}
+
+void PropertyLookupCache::add_entry(Entry entry)
+{
+    VERIFY(!is_megamorphic);
+    VERIFY(entry.shape);
+
+    // An existing entry for the same shape is stale (e.g. its prototype chain was invalidated), so it gets replaced.
+    // Otherwise we take the first slot whose shape has been garbage collected, if any.
+    Optional<size_t> slot_to_replace;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].shape.ptr() == entry.shape.ptr()) {
+            slot_to_replace = i;
+            break;
+        }
+    }
+    if (!slot_to_replace.has_value()) {
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (!entries[i].shape) {
+                slot_to_replace = i;
+                break;
+            }
+        }
+    }
+
+    if (!slot_to_replace.has_value()) {
+        is_megamorphic = true;
+        entries = {};
+        return;
+    }
+
+    for (size_t i = *slot_to_replace; i > 0; --i)
+        entries[i] = move(entries[i - 1]);
+    entries[0] = move(entry);
+}
+
+size_t MegamorphicPropertyLookupCache::slot_index(Shape const& shape, FlyString const& property_name)
+{
+    static_assert(is_power_of_two(number_of_slots));
+    return pair_int_hash(ptr_hash(&shape), property_name.hash()) & (number_of_slots - 1);
+}
+
+PropertyLookupCache::Entry const* MegamorphicPropertyLookupCache::find(Shape const& shape, FlyString const& property_name) const
+{
+    auto const& slot = m_slots[slot_index(shape, property_name)];
+    if (slot.entry.shape.ptr() != &shape || slot.property_name != property_name)
+        return nullptr;
+    return &slot.entry;
+}
+
+void MegamorphicPropertyLookupCache::set(Shape const& shape, FlyString const& property_name, PropertyLookupCache::Entry entry)
+{
+    auto& slot = m_slots[slot_index(shape, property_name)];
+    slot.entry = move(entry);
+    slot.property_name = property_name;
+}
 
 void Executable::dump() const
 {
@@ -84,6 +167,37 @@ void Executable::dump() const
     warnln("");
 }
 
+#if JS_BYTECODE_DEBUG
+void Executable::dump_property_lookup_cache_statistics() const
+{
+    bool printed_header = false;
+    for (size_t i = 0; i < property_lookup_caches.size(); ++i) {
+        auto const& cache = property_lookup_caches[i];
+        auto total = cache.hit_count + cache.miss_count;
+        if (total == 0)
+            continue;
+
+        if (!printed_header) {
+            warnln("\033[37;1mProperty lookup caches\033[0m \"{}\"", name);
+            printed_header = true;
+        }
+
+        size_t number_of_shapes = 0;
+        for (auto const& entry : cache.entries) {
+            if (entry.shape)
+                ++number_of_shapes;
+        }
+
+        warnln("    #{:<4} hits {:>8} misses {:>8} ({:3}% hit) {}",
+            i,
+            cache.hit_count,
+            cache.miss_count,
+            cache.hit_count * 100 / total,
+            cache.is_megamorphic ? "megamorphic"sv : (number_of_shapes > 1 ? "polymorphic"sv : "monomorphic"sv));
+    }
+}
+#endif
+
 void Executable::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
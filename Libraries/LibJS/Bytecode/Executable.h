@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Debug.h>
 #include <AK/FlyString.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
@@ -23,13 +25,60 @@
 namespace JS::Bytecode {
 
 struct PropertyLookupCache {
-    WeakPtr<Shape> shape;
-    Optional<u32> property_offset;
-    WeakPtr<Object> prototype;
-    WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    static constexpr size_t max_number_of_shapes_to_remember = 4;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        Optional<u32> property_offset;
+        WeakPtr<Object> prototype;
+        WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    };
+
+    // Ordered from most to least recently added.
+    AK::Array<Entry, max_number_of_shapes_to_remember> entries;
+
+    // Set once this site has seen more shapes than fit in `entries`.
+    // From then on, lookups go through the interpreter's MegamorphicPropertyLookupCache instead.
+    bool is_megamorphic { false };
+
+    // NOTE: Counting hits and misses isn't free, so it's only compiled in when debugging the bytecode.
+#if JS_BYTECODE_DEBUG
+    u64 hit_count { 0 };
+    u64 miss_count { 0 };
+
+    ALWAYS_INLINE void record_hit() { ++hit_count; }
+    ALWAYS_INLINE void record_miss() { ++miss_count; }
+#else
+    ALWAYS_INLINE void record_hit() { }
+    ALWAYS_INLINE void record_miss() { }
+#endif
+
+    void add_entry(Entry);
+};
+
+// Shared by all megamorphic lookup sites in an interpreter.
+// This is a direct-mapped table keyed on (shape, property name); colliding entries simply evict each other.
+class MegamorphicPropertyLookupCache {
+public:
+    static constexpr size_t number_of_slots = 1024;
+
+    PropertyLookupCache::Entry const* find(Shape const&, FlyString const& property_name) const;
+    void set(Shape const&, FlyString const& property_name, PropertyLookupCache::Entry);
+
+private:
+    struct Slot {
+        PropertyLookupCache::Entry entry;
+        FlyString property_name;
+    };
+
+    static size_t slot_index(Shape const&, FlyString const& property_name);
+
+    AK::Array<Slot, number_of_slots> m_slots;
 };
 
-struct GlobalVariableCache : public PropertyLookupCache {
+struct GlobalVariableCache {
+    WeakPtr<Shape> shape;
+    Optional<u32> property_offset;
     u64 environment_serial_number { 0 };
     u32 environment_binding_index { 0 };
     bool has_environment_binding_index { false };
@@ -106,9 +155,19 @@ public:
     [[nodiscard]] UnrealizedSourceRange source_range_at(size_t offset) const;
 
     void dump() const;
+#if JS_BYTECODE_DEBUG
+    void dump_property_lookup_cache_statistics() const;
+#endif
+
+    // An estimate of the memory this executable keeps alive. It's computed once code generation is done, and
+    // accounted to the source code it was generated from until the executable is destroyed.
+    size_t memory_usage() const { return m_memory_usage; }
+    void did_finish_code_generation(Badge<Generator>);
 
 private:
     virtual void visit_edges(Visitor&) override;
+
+    size_t m_memory_usage { 0 };
 };
 
 }
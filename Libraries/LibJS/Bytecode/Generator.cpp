@@ -11,6 +11,7 @@
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
 #include <LibJS/Bytecode/Register.h>
 #include <LibJS/Runtime/ECMAScriptFunctionObject.h>
 #include <LibJS/Runtime/VM.h>
@@ -215,6 +216,19 @@ CodeGenerationErrorOr<void> Generator::emit_function_declaration_instantiation(E
     return {};
 }
 
+static PassManager& default_pass_manager()
+{
+    static auto pass_manager = [] {
+        auto pass_manager = make<PassManager>();
+        pass_manager->add<Passes::Peephole>();
+        pass_manager->add<Passes::ThreadJumps>();
+        pass_manager->add<Passes::DuplicateBranchBlocks>();
+        pass_manager->add<Passes::EliminateDeadBlocks>();
+        return pass_manager;
+    }();
+    return *pass_manager;
+}
+
 CodeGenerationErrorOr<GC::Ref<Executable>> Generator::compile(VM& vm, ASTNode const& node, FunctionKind enclosing_function_kind, GC::Ptr<ECMAScriptFunctionObject const> function, MustPropagateCompletion must_propagate_completion, Vector<FlyString> local_variable_names)
 {
     Generator generator(vm, function, must_propagate_completion);
@@ -259,6 +273,9 @@ CodeGenerationErrorOr<GC::Ref<Executable>> Generator::compile(VM& vm, ASTNode co
         }
     }
 
+    PassPipelineExecutable pass_pipeline_executable { generator.m_root_basic_blocks, generator.m_constants };
+    default_pass_manager().perform(pass_pipeline_executable);
+
     bool is_strict_mode = false;
     if (is<Program>(node))
         is_strict_mode = static_cast<Program const&>(node).is_strict_mode();
@@ -475,6 +492,7 @@ CodeGenerationErrorOr<GC::Ref<Executable>> Generator::compile(VM& vm, ASTNode co
     executable->local_index_base = number_of_registers + number_of_constants;
     executable->argument_index_base = number_of_registers + number_of_constants + number_of_locals;
     executable->length_identifier = generator.m_length_identifier;
+    executable->did_finish_code_generation({});
 
     generator.m_finished = true;
 
@@ -16,6 +16,7 @@
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -68,6 +69,7 @@ struct Traits<JS::PropertyKeyAndEnumerableFlag> : public DefaultTraits<JS::Prope
 namespace JS::Bytecode {
 
 bool g_dump_bytecode = false;
+bool g_dump_property_lookup_cache_statistics = false;
 
 static ByteString format_operand(StringView name, Operand operand, Bytecode::Executable const& executable)
 {
@@ -223,7 +225,10 @@ ThrowCompletionOr<Value> Interpreter::run(Script& script_record, GC::Ptr<Environ
     Completion result = instantiation_result.is_throw_completion() ? instantiation_result.throw_completion() : normal_completion(js_undefined());
 
     GC::Ptr<Executable> executable;
-    if (result.type() == Completion::Type::Normal) {
+    if (result.type() == Completion::Type::Normal && script.bytecode_executable()) {
+        // NOTE: This script's AST came from (or went into) the program cache, and we've already compiled it before.
+        executable = script.bytecode_executable();
+    } else if (result.type() == Completion::Type::Normal) {
         auto executable_result = JS::Bytecode::Generator::generate_from_ast_node(vm, script, {});
 
         if (executable_result.is_error()) {
@@ -238,6 +243,10 @@ ThrowCompletionOr<Value> Interpreter::run(Script& script_record, GC::Ptr<Environ
 
             if (g_dump_bytecode)
                 executable->dump();
+
+            // NOTE: Only ASTs that may be evaluated again are worth keeping the top-level executable alive for.
+            if (vm.program_cache().contains(script))
+                const_cast<Program&>(script).set_bytecode_executable(executable);
         }
     }
 
@@ -978,6 +987,18 @@ enum class GetByIdMode {
     Length,
 };
 
+ALWAYS_INLINE bool cache_entry_applies_to_shape(PropertyLookupCache::Entry const& entry, Shape const& shape)
+{
+    if (&shape != entry.shape)
+        return false;
+    if (!entry.prototype)
+        return true;
+    // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
+    if (!entry.prototype_chain_validity)
+        return false;
+    return entry.prototype_chain_validity->is_valid();
+}
+
 template<GetByIdMode mode = GetByIdMode::Normal>
 inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex> base_identifier, IdentifierTableIndex property, Value base_value, Value this_value, PropertyLookupCache& cache, Executable const& executable)
 {
@@ -997,47 +1018,50 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
     }
 
     auto& shape = base_obj->shape();
+    auto const& property_name = executable.get_identifier(property);
 
-    if (cache.prototype) {
-        // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
-        bool can_use_cache = [&]() -> bool {
-            if (&shape != cache.shape)
-                return false;
-            if (!cache.prototype_chain_validity)
-                return false;
-            if (!cache.prototype_chain_validity->is_valid())
-                return false;
-            return true;
-        }();
-        if (can_use_cache) {
-            auto value = cache.prototype->get_direct(cache.property_offset.value());
-            if (value.is_accessor())
-                return TRY(call(vm, value.as_accessor().getter(), this_value));
-            return value;
-        }
-    } else if (&shape == cache.shape) {
-        // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
-        auto value = base_obj->get_direct(cache.property_offset.value());
+    auto get_cached_value = [&](PropertyLookupCache::Entry const& entry) -> ThrowCompletionOr<Value> {
+        auto value = entry.prototype ? entry.prototype->get_direct(entry.property_offset.value()) : base_obj->get_direct(entry.property_offset.value());
         if (value.is_accessor())
             return TRY(call(vm, value.as_accessor().getter(), this_value));
         return value;
+    };
+
+    if (!cache.is_megamorphic) {
+        for (auto const& entry : cache.entries) {
+            if (cache_entry_applies_to_shape(entry, shape)) {
+                cache.record_hit();
+                return get_cached_value(entry);
+            }
+        }
+    } else if (auto const* entry = vm.bytecode_interpreter().megamorphic_get_cache().find(shape, property_name); entry && cache_entry_applies_to_shape(*entry, shape)) {
+        cache.record_hit();
+        return get_cached_value(*entry);
     }
 
+    cache.record_miss();
+
     CacheablePropertyMetadata cacheable_metadata;
-    auto value = TRY(base_obj->internal_get(executable.get_identifier(property), this_value, &cacheable_metadata));
+    auto value = TRY(base_obj->internal_get(property_name, this_value, &cacheable_metadata));
 
+    PropertyLookupCache::Entry new_entry;
     if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-        cache = {};
-        cache.shape = shape;
-        cache.property_offset = cacheable_metadata.property_offset.value();
+        new_entry.shape = shape;
+        new_entry.property_offset = cacheable_metadata.property_offset.value();
     } else if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
-        cache = {};
-        cache.shape = &base_obj->shape();
-        cache.property_offset = cacheable_metadata.property_offset.value();
-        cache.prototype = *cacheable_metadata.prototype;
-        cache.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+        new_entry.shape = &base_obj->shape();
+        new_entry.property_offset = cacheable_metadata.property_offset.value();
+        new_entry.prototype = *cacheable_metadata.prototype;
+        new_entry.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+    } else {
+        return value;
     }
 
+    if (!cache.is_megamorphic)
+        cache.add_entry(new_entry);
+    if (cache.is_megamorphic)
+        vm.bytecode_interpreter().megamorphic_get_cache().set(*new_entry.shape, property_name, move(new_entry));
+
     return value;
 }
 
@@ -1224,17 +1248,37 @@ inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value thi
         break;
     }
     case Op::PropertyKind::KeyValue: {
-        if (cache && cache->shape == &object->shape()) {
-            object->put_direct(*cache->property_offset, value);
-            return {};
+        if (cache) {
+            auto& shape = object->shape();
+            if (!cache->is_megamorphic) {
+                for (auto const& entry : cache->entries) {
+                    if (entry.shape == &shape) {
+                        cache->record_hit();
+                        object->put_direct(*entry.property_offset, value);
+                        return {};
+                    }
+                }
+            } else if (name.is_string()) {
+                if (auto const* entry = vm.bytecode_interpreter().megamorphic_put_cache().find(shape, name.as_string())) {
+                    cache->record_hit();
+                    object->put_direct(*entry->property_offset, value);
+                    return {};
+                }
+            }
+            cache->record_miss();
         }
 
         CacheablePropertyMetadata cacheable_metadata;
         bool succeeded = TRY(object->internal_set(name, value, this_value, &cacheable_metadata));
 
         if (succeeded && cache && cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-            cache->shape = object->shape();
-            cache->property_offset = cacheable_metadata.property_offset.value();
+            PropertyLookupCache::Entry new_entry;
+            new_entry.shape = object->shape();
+            new_entry.property_offset = cacheable_metadata.property_offset.value();
+            if (!cache->is_megamorphic)
+                cache->add_entry(new_entry);
+            if (cache->is_megamorphic && name.is_string())
+                vm.bytecode_interpreter().megamorphic_put_cache().set(*new_entry.shape, name.as_string(), move(new_entry));
         }
 
         if (!succeeded && vm.in_strict_mode()) {
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// Blocks bigger than this are not worth the extra code size.
+static constexpr size_t max_duplicated_block_size = 128;
+
+static bool is_two_way_branch(Instruction const& instruction)
+{
+    switch (instruction.type()) {
+    case Instruction::Type::JumpIf:
+    case Instruction::Type::JumpNullish:
+    case Instruction::Type::JumpUndefined:
+    case Instruction::Type::JumpGreaterThan:
+    case Instruction::Type::JumpGreaterThanEquals:
+    case Instruction::Type::JumpLessThan:
+    case Instruction::Type::JumpLessThanEquals:
+    case Instruction::Type::JumpLooselyEquals:
+    case Instruction::Type::JumpLooselyInequals:
+    case Instruction::Type::JumpStrictlyEquals:
+    case Instruction::Type::JumpStrictlyInequals:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Instructions are relocated bytewise anyway, but ones that own out-of-line data can't live in two places at once.
+static bool can_be_duplicated(Instruction const& instruction)
+{
+#define __BYTECODE_OP(op)       \
+    case Instruction::Type::op: \
+        return IsTriviallyDestructible<Op::op>;
+
+    switch (instruction.type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+#undef __BYTECODE_OP
+}
+
+static bool is_duplication_candidate(BasicBlock const& block)
+{
+    if (!block.is_terminated() || block.size() == 0 || block.size() > max_duplicated_block_size)
+        return false;
+    for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+        if (!can_be_duplicated(*it))
+            return false;
+        if (it.offset() == block.last_instruction_start_offset())
+            return is_two_way_branch(*it);
+    }
+    return false;
+}
+
+static Optional<Label> trailing_jump_target(BasicBlock const& block)
+{
+    if (!block.is_terminated() || block.size() == 0)
+        return {};
+    auto const& instruction = *reinterpret_cast<Instruction const*>(block.data() + block.last_instruction_start_offset());
+    if (instruction.type() != Instruction::Type::Jump)
+        return {};
+    return static_cast<Op::Jump const&>(instruction).target();
+}
+
+// Loops whose test lives in its own block (`while`, `for..of`, `do..while` with `continue`, ...) pay for an
+// unconditional jump back to the test on every iteration. Copying the test into the end of the loop body
+// turns that into a single dispatch, and lets EliminateDeadBlocks drop the original if nothing else uses it.
+void DuplicateBranchBlocks::perform(PassPipelineExecutable& executable)
+{
+    auto& blocks = executable.basic_blocks;
+
+    for (auto& block : blocks) {
+        auto target_label = trailing_jump_target(*block);
+        if (!target_label.has_value())
+            continue;
+
+        auto const& target = *blocks[target_label->basic_block_index()];
+        if (&target == block.ptr() || !is_duplication_candidate(target))
+            continue;
+        // The copied instructions must unwind to the same place as the originals would have.
+        if (target.handler() != block->handler() || target.finalizer() != block->finalizer())
+            continue;
+
+        auto jump_offset = block->last_instruction_start_offset();
+
+        Vector<u8> buffer;
+        buffer.ensure_capacity(jump_offset + target.size());
+        buffer.append(block->data(), jump_offset);
+
+        HashMap<size_t, SourceRecord> source_map;
+        for (auto const& [offset, source_record] : block->source_map()) {
+            if (offset < jump_offset)
+                source_map.set(offset, source_record);
+        }
+        for (auto const& [offset, source_record] : target.source_map())
+            source_map.set(jump_offset + offset, source_record);
+
+        // NOTE: Every instruction in the target is trivially destructible, so the copy and the original can
+        //       coexist and be destroyed independently.
+        buffer.append(target.data(), target.size());
+        auto last_instruction_start_offset = jump_offset + target.last_instruction_start_offset();
+
+        Instruction::destroy(*reinterpret_cast<Instruction*>(block->data() + jump_offset));
+        block->replace_instruction_stream(move(buffer), move(source_map), last_instruction_start_offset);
+    }
+}
+
+}
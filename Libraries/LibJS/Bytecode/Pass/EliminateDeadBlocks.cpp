@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+void EliminateDeadBlocks::perform(PassPipelineExecutable& executable)
+{
+    auto& blocks = executable.basic_blocks;
+    if (blocks.is_empty())
+        return;
+
+    // Execution always starts in the first block. From there, control can only reach other blocks
+    // through labels, or by throwing into a handler or finalizer.
+    Vector<bool> is_reachable;
+    is_reachable.resize(blocks.size());
+
+    Vector<BasicBlock const*> worklist;
+    auto enqueue = [&](BasicBlock const& block) {
+        if (is_reachable[block.index()])
+            return;
+        is_reachable[block.index()] = true;
+        worklist.append(&block);
+    };
+
+    enqueue(*blocks.first());
+    while (!worklist.is_empty()) {
+        auto const& block = *worklist.take_last();
+        if (block.handler())
+            enqueue(*block.handler());
+        if (block.finalizer())
+            enqueue(*block.finalizer());
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+            const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                enqueue(*blocks[label.basic_block_index()]);
+            });
+        }
+    }
+
+    if (!is_reachable.contains_slow(false))
+        return;
+
+    Vector<u32> new_index_for_old_index;
+    new_index_for_old_index.resize(blocks.size());
+
+    Vector<NonnullOwnPtr<BasicBlock>> live_blocks;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (!is_reachable[i])
+            continue;
+        new_index_for_old_index[i] = live_blocks.size();
+        blocks[i]->set_index(live_blocks.size());
+        live_blocks.append(move(blocks[i]));
+    }
+
+    for (auto& block : live_blocks) {
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                label = Label { new_index_for_old_index[label.basic_block_index()] };
+            });
+        }
+    }
+
+    // NOTE: Dead blocks are destroyed here, which also destroys their instructions.
+    blocks = move(live_blocks);
+}
+
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+static Optional<Value> constant_value(PassPipelineExecutable const& executable, Operand operand)
+{
+    if (!operand.is_constant())
+        return {};
+    auto value = executable.constants[operand.index()];
+    if (value.is_special_empty_value())
+        return {};
+    return value;
+}
+
+// If the instruction is a conditional jump that always goes the same way, returns where it goes.
+static Optional<Label> known_jump_target(PassPipelineExecutable const& executable, Instruction const& instruction)
+{
+    switch (instruction.type()) {
+    case Instruction::Type::JumpIf: {
+        auto const& jump = static_cast<Op::JumpIf const&>(instruction);
+        if (jump.true_target().basic_block_index() == jump.false_target().basic_block_index())
+            return jump.true_target();
+        // NOTE: Constants are always primitives, so ToBoolean can't have side effects here.
+        if (auto value = constant_value(executable, jump.condition()); value.has_value())
+            return value->to_boolean() ? jump.true_target() : jump.false_target();
+        return {};
+    }
+    case Instruction::Type::JumpNullish: {
+        auto const& jump = static_cast<Op::JumpNullish const&>(instruction);
+        if (auto value = constant_value(executable, jump.condition()); value.has_value())
+            return value->is_nullish() ? jump.true_target() : jump.false_target();
+        return {};
+    }
+    case Instruction::Type::JumpUndefined: {
+        auto const& jump = static_cast<Op::JumpUndefined const&>(instruction);
+        if (auto value = constant_value(executable, jump.condition()); value.has_value())
+            return value->is_undefined() ? jump.true_target() : jump.false_target();
+        return {};
+    }
+    default:
+        return {};
+    }
+}
+
+static bool is_redundant_move(Instruction const& instruction)
+{
+    if (instruction.type() != Instruction::Type::Mov)
+        return false;
+    auto const& mov = static_cast<Op::Mov const&>(instruction);
+    return mov.dst() == mov.src();
+}
+
+void Peephole::perform(PassPipelineExecutable& executable)
+{
+    for (auto& block : executable.basic_blocks) {
+        bool needs_rewrite = false;
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            if (is_redundant_move(*it) || known_jump_target(executable, *it).has_value()) {
+                needs_rewrite = true;
+                break;
+            }
+        }
+        if (!needs_rewrite)
+            continue;
+
+        Vector<u8> buffer;
+        buffer.ensure_capacity(block->size());
+        HashMap<size_t, SourceRecord> source_map;
+        size_t last_instruction_start_offset = 0;
+
+        auto append = [&](Instruction const& instruction, size_t old_offset) {
+            if (auto source_record = block->source_map().get(old_offset); source_record.has_value())
+                source_map.set(buffer.size(), *source_record);
+            last_instruction_start_offset = buffer.size();
+            buffer.append(reinterpret_cast<u8 const*>(&instruction), instruction.length());
+        };
+
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end();) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            auto offset = it.offset();
+            ++it;
+
+            if (is_redundant_move(instruction)) {
+                Instruction::destroy(instruction);
+                continue;
+            }
+            if (auto target = known_jump_target(executable, instruction); target.has_value()) {
+                Op::Jump jump(*target);
+                append(jump, offset);
+                Instruction::destroy(instruction);
+                continue;
+            }
+            // NOTE: The instruction is relocated bytewise, same as when linking the final executable.
+            append(instruction, offset);
+        }
+
+        block->replace_instruction_stream(move(buffer), move(source_map), last_instruction_start_offset);
+    }
+}
+
+}
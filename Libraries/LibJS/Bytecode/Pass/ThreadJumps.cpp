@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// Returns the target of the block's only instruction, if that instruction is an unconditional jump.
+static Optional<Label> forwarding_target(BasicBlock const& block)
+{
+    InstructionStreamIterator it(block.instruction_stream());
+    if (it.at_end())
+        return {};
+    auto const& instruction = *it;
+    if (instruction.type() != Instruction::Type::Jump)
+        return {};
+    ++it;
+    if (!it.at_end())
+        return {};
+    return static_cast<Op::Jump const&>(instruction).target();
+}
+
+void ThreadJumps::perform(PassPipelineExecutable& executable)
+{
+    auto& blocks = executable.basic_blocks;
+
+    Vector<Optional<Label>> forwarding_targets;
+    forwarding_targets.ensure_capacity(blocks.size());
+    for (auto& block : blocks)
+        forwarding_targets.unchecked_append(forwarding_target(*block));
+
+    auto resolve = [&](Label label) {
+        // NOTE: The hop limit keeps us from spinning on a cycle of empty blocks, i.e. `while (true) {}`.
+        for (size_t hops = 0; hops < blocks.size(); ++hops) {
+            auto const& next = forwarding_targets[label.basic_block_index()];
+            if (!next.has_value() || next->basic_block_index() == label.basic_block_index())
+                break;
+            label = *next;
+        }
+        return label;
+    };
+
+    // Jumping into a block that consists of a single `Jump` can't throw or observe anything,
+    // so every label (including yield and await continuations) can skip straight past it.
+    for (auto& block : blocks) {
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                label = resolve(label);
+            });
+        }
+    }
+}
+
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS::Bytecode {
+
+// The basic blocks of an executable that has been generated but not yet linked.
+// Operands still refer to unshifted register/constant/local indices, and labels still refer to basic block indices.
+struct PassPipelineExecutable {
+    Vector<NonnullOwnPtr<BasicBlock>>& basic_blocks;
+    Vector<Value> const& constants;
+};
+
+class Pass {
+public:
+    virtual ~Pass() = default;
+
+    virtual void perform(PassPipelineExecutable&) = 0;
+};
+
+class PassManager final : public Pass {
+public:
+    PassManager() = default;
+    virtual ~PassManager() override = default;
+
+    template<typename PassT, typename... Args>
+    void add(Args&&... args) { m_passes.append(make<PassT>(forward<Args>(args)...)); }
+
+    virtual void perform(PassPipelineExecutable& executable) override
+    {
+        for (auto& pass : m_passes)
+            pass->perform(executable);
+    }
+
+private:
+    Vector<NonnullOwnPtr<Pass>> m_passes;
+};
+
+namespace Passes {
+
+// Drops `Mov x, x`, and turns conditional jumps whose outcome is known at compile time into plain jumps.
+class Peephole final : public Pass {
+public:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Retargets labels pointing at blocks that do nothing but jump somewhere else.
+class ThreadJumps final : public Pass {
+public:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Replaces unconditional jumps to small blocks ending in a conditional branch with a copy of that block.
+class DuplicateBranchBlocks final : public Pass {
+public:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Removes blocks that can't be reached from the entry block, then renumbers the remaining ones.
+class EliminateDeadBlocks final : public Pass {
+public:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+}
+
+}
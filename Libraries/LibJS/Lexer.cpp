@@ -189,9 +189,9 @@ static constexpr TokenType parse_three_char_token(StringView view)
     }
 }
 
-static consteval Array<TokenType, 256> make_single_char_tokens_array()
+static consteval AK::Array<TokenType, 256> make_single_char_tokens_array()
 {
-    Array<TokenType, 256> array;
+    AK::Array<TokenType, 256> array;
     array.fill(TokenType::Invalid);
     array['&'] = TokenType::Ampersand;
     array['*'] = TokenType::Asterisk;
@@ -223,12 +223,38 @@ static consteval Array<TokenType, 256> make_single_char_tokens_array()
 static constexpr auto s_single_char_tokens = make_single_char_tokens_array();
 
 Lexer::Lexer(StringView source, StringView filename, size_t line_number, size_t line_column)
-    : m_source(source)
+    : m_source_storage(source)
+    , m_source(m_source_storage)
     , m_current_token(TokenType::Eof, {}, {}, {}, 0, 0, 0)
     , m_filename(String::from_utf8(filename).release_value_but_fixme_should_propagate_errors())
     , m_line_number(line_number)
     , m_line_column(line_column)
     , m_parsed_identifiers(adopt_ref(*new ParsedIdentifiers))
+{
+    initialize_keywords_if_needed();
+    consume();
+}
+
+Lexer::Lexer(NonnullRefPtr<SourceCode const> source_code, Position const& resume_after)
+    : m_source_code(move(source_code))
+    , m_source(m_source_code->code().bytes_as_string_view())
+    , m_current_token(TokenType::Eof, {}, {}, {}, 0, 0, 0)
+    , m_filename(m_source_code->filename())
+    , m_line_number(resume_after.line)
+    , m_line_column(resume_after.column)
+    , m_parsed_identifiers(adopt_ref(*new ParsedIdentifiers))
+{
+    initialize_keywords_if_needed();
+
+    // Put ourselves into the state we would have been in right after consuming the character at the
+    // given position, so that the next call to consume() moves on to the character following it.
+    VERIFY(resume_after.offset < m_source.length());
+    m_position = resume_after.offset + 1;
+    m_current_char = m_source[resume_after.offset];
+    consume();
+}
+
+void Lexer::initialize_keywords_if_needed()
 {
     if (s_keywords.is_empty()) {
         s_keywords.set("async"_fly_string, TokenType::Async);
@@ -272,8 +298,6 @@ Lexer::Lexer(StringView source, StringView filename, size_t line_number, size_t
         s_keywords.set("with"_fly_string, TokenType::With);
         s_keywords.set("yield"_fly_string, TokenType::Yield);
     }
-
-    consume();
 }
 
 void Lexer::consume()
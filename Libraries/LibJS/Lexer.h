@@ -12,6 +12,7 @@
 #include <AK/HashMap.h>
 #include <AK/String.h>
 #include <AK/StringView.h>
+#include <LibJS/SourceCode.h>
 
 namespace JS {
 
@@ -19,9 +20,14 @@ class Lexer {
 public:
     explicit Lexer(StringView source, StringView filename = "(unknown)"sv, size_t line_number = 1, size_t line_column = 0);
 
+    // Resumes lexing already parsed source code right after the character at the given position,
+    // without making another copy of the source text.
+    Lexer(NonnullRefPtr<SourceCode const>, Position const& resume_after);
+
     Token next();
 
-    ByteString const& source() const { return m_source; }
+    StringView source() const { return m_source; }
+    RefPtr<SourceCode const> const& source_code() const { return m_source_code; }
     String const& filename() const { return m_filename; }
 
     void disallow_html_comments() { m_allow_html_comments = false; }
@@ -58,7 +64,12 @@ private:
 
     TokenType consume_regex_literal();
 
-    ByteString m_source;
+    static void initialize_keywords_if_needed();
+
+    // m_source views either m_source_storage or the code of m_source_code, whichever we were created from.
+    ByteString m_source_storage;
+    RefPtr<SourceCode const> m_source_code;
+    StringView m_source;
     size_t m_position { 0 };
     Token m_current_token;
     char m_current_char { 0 };
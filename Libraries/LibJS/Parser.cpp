@@ -397,6 +397,9 @@ public:
                 if (m_contains_direct_call_to_eval)
                     identifier_group.used_inside_scope_with_eval = true;
 
+                if (m_free_identifiers)
+                    m_free_identifiers->append(identifier_group.identifiers.first());
+
                 if (m_parent_scope) {
                     if (auto maybe_parent_scope_identifier_group = m_parent_scope->m_identifier_groups.get(identifier_group_name); maybe_parent_scope_identifier_group.has_value()) {
                         maybe_parent_scope_identifier_group.value().identifiers.extend(identifier_group.identifiers);
@@ -411,6 +414,11 @@ public:
                     } else {
                         m_parent_scope->m_identifier_groups.set(identifier_group_name, identifier_group);
                     }
+                } else if (m_parser.m_lazy_function_global_identifier_names && m_parser.m_lazy_function_global_identifier_names->contains(identifier_group_name)) {
+                    // NOTE: We are reparsing a lazy function body on its own, so there is no program scope to decide
+                    //       this. Reuse whatever the parse of the whole program decided instead.
+                    for (auto& identifier : identifier_group.identifiers)
+                        identifier->set_is_global();
                 }
             }
         }
@@ -490,6 +498,12 @@ public:
         m_is_arrow_function = true;
     }
 
+    // Collects one identifier for each name that is left unresolved when this scope is closed.
+    void collect_free_identifiers_into(Vector<NonnullRefPtr<Identifier const>>& free_identifiers)
+    {
+        m_free_identifiers = &free_identifiers;
+    }
+
 private:
     void throw_identifier_declared(FlyString const& name, NonnullRefPtr<Declaration const> const& declaration)
     {
@@ -539,6 +553,8 @@ private:
     bool m_uses_this_from_environment { false };
     bool m_uses_this { false };
     bool m_is_arrow_function { false };
+
+    Vector<NonnullRefPtr<Identifier const>>* m_free_identifiers { nullptr };
 };
 
 class OperatorPrecedenceTable {
@@ -675,8 +691,15 @@ Parser::ParserState::ParserState(Lexer l, Program::Type program_type)
     current_token = lexer.next();
 }
 
+static NonnullRefPtr<SourceCode const> source_code_for_lexer(Lexer const& lexer)
+{
+    if (auto const& source_code = lexer.source_code())
+        return *source_code;
+    return SourceCode::create(lexer.filename(), String::from_utf8(lexer.source()).release_value_but_fixme_should_propagate_errors());
+}
+
 Parser::Parser(Lexer lexer, Program::Type program_type, Optional<EvalInitialState> initial_state_for_eval)
-    : m_source_code(SourceCode::create(lexer.filename(), String::from_byte_string(lexer.source()).release_value_but_fixme_should_propagate_errors()))
+    : m_source_code(source_code_for_lexer(lexer))
     , m_state(move(lexer), program_type)
     , m_program_type(program_type)
 {
@@ -761,16 +784,26 @@ bool Parser::parse_directive(ScopeNode& body)
 
 NonnullRefPtr<Program> Parser::parse_program(bool starts_in_strict_mode)
 {
+    auto ast_node_memory_allocated_at_start = g_ast_node_memory_allocated;
     auto rule_start = push_start();
     auto program = adopt_ref(*new Program({ m_source_code, rule_start.position(), position() }, m_program_type));
-    ScopePusher program_scope = ScopePusher::program_scope(*this, *program);
+    {
+        ScopePusher program_scope = ScopePusher::program_scope(*this, *program);
 
-    if (m_program_type == Program::Type::Script)
-        parse_script(program, starts_in_strict_mode);
-    else
-        parse_module(program);
+        if (m_program_type == Program::Type::Script)
+            parse_script(program, starts_in_strict_mode);
+        else
+            parse_module(program);
+    }
 
     program->set_end_offset({}, position().offset);
+
+    // NOTE: This has to happen after the program scope is closed, as that is where global variable accesses are decided.
+    if (!has_errors())
+        drop_lazy_function_bodies();
+
+    program->set_ast_memory_usage({}, sizeof(Program) + g_ast_node_memory_allocated - ast_node_memory_allocated_at_start);
+
     return program;
 }
 
@@ -2974,11 +3007,30 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
     TemporaryChange generator_change(m_state.in_generator_function_context, function_kind == FunctionKind::Generator || function_kind == FunctionKind::AsyncGenerator);
     TemporaryChange async_change(m_state.await_expression_is_valid, function_kind == FunctionKind::Async || function_kind == FunctionKind::AsyncGenerator);
 
+    // Plain functions nested in other functions are often never called, which makes them candidates for
+    // having their body dropped after parsing, see drop_lazy_function_bodies().
+    constexpr u16 options_preventing_lazy_body = FunctionNodeParseOptions::AllowSuperPropertyLookup
+        | FunctionNodeParseOptions::AllowSuperConstructorCall
+        | FunctionNodeParseOptions::IsGetterFunction
+        | FunctionNodeParseOptions::IsSetterFunction
+        | FunctionNodeParseOptions::IsArrowFunction
+        | FunctionNodeParseOptions::HasDefaultExportName
+        | FunctionNodeParseOptions::IsConstructor;
+    auto might_have_lazy_body = (parse_options & FunctionNodeParseOptions::CheckForFunctionAndName) != 0
+        && (parse_options & options_preventing_lazy_body) == 0
+        && (m_state.in_function_context || m_state.in_arrow_function_context)
+        && !m_state.initiated_by_eval;
+    auto strict_mode_outside_function = m_state.strict_mode;
+    Position opening_curly_position;
+    Vector<NonnullRefPtr<Identifier const>> free_identifiers;
+
     i32 function_length = -1;
     RefPtr<FunctionParameters const> parameters;
     FunctionParsingInsights parsing_insights;
     auto body = [&] {
         ScopePusher function_scope = ScopePusher::function_scope(*this, name);
+        if (might_have_lazy_body)
+            function_scope.collect_free_identifiers_into(free_identifiers);
 
         consume(TokenType::ParenOpen);
         parameters = parse_formal_parameters(function_length, parse_options);
@@ -2994,12 +3046,14 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
             m_state.labels_in_scope = move(old_labels_in_scope);
         });
 
+        opening_curly_position = position();
         consume(TokenType::CurlyOpen);
 
         return parse_function_body(*parameters, function_kind, parsing_insights);
     }();
 
     auto local_variables_names = body->local_variables_names();
+    auto closing_curly_offset = position().offset;
     consume(TokenType::CurlyClose);
 
     auto has_strict_directive = body->in_strict_mode();
@@ -3015,11 +3069,29 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
         parsing_insights.uses_this = true;
         parsing_insights.uses_this_from_environment = true;
     }
-    return create_ast_node<FunctionNodeType>(
+    auto function_node = create_ast_node<FunctionNodeType>(
         { m_source_code, rule_start.position(), position() },
         name, move(source_text), move(body), parameters.release_nonnull(), function_length,
         function_kind, has_strict_directive, parsing_insights,
         move(local_variables_names));
+
+    // NOTE: Reparsing tiny functions costs more than keeping them around.
+    static constexpr size_t minimum_lazy_function_body_length = 64;
+    if (might_have_lazy_body
+        && !parsing_insights.contains_direct_call_to_eval
+        && is_simple_parameter_list(*function_node->parameters())
+        && closing_curly_offset - opening_curly_position.offset >= minimum_lazy_function_body_length) {
+        m_lazy_function_candidates.append({
+            .node = function_node,
+            .function = *function_node,
+            .opening_curly_position = opening_curly_position,
+            .closing_curly_offset = closing_curly_offset,
+            .strict_mode = strict_mode_outside_function,
+            .free_identifiers = move(free_identifiers),
+        });
+    }
+
+    return function_node;
 }
 
 NonnullRefPtr<FunctionParameters const> Parser::parse_formal_parameters(int& function_length, u16 parse_options)
@@ -5208,6 +5280,68 @@ NonnullRefPtr<Identifier const> Parser::create_identifier_and_register_in_curren
     return id;
 }
 
+// Functions nested in other functions are only instantiated when their enclosing function runs, which many of them
+// never do. To avoid holding on to their AST for nothing, we drop their bodies once the whole program has been
+// parsed (and thus checked for early errors), and parse them again on demand via parse_lazy_function_body().
+void Parser::drop_lazy_function_bodies()
+{
+    // NOTE: Candidates are recorded after their body has been parsed, so walking them backwards visits each function
+    //       before the ones nested inside it. Those don't need any work, as they go away with the outer body.
+    LazyFunctionCandidate const* outer_lazy_function = nullptr;
+    for (auto const& candidate : m_lazy_function_candidates.in_reverse()) {
+        if (outer_lazy_function
+            && candidate.opening_curly_position.offset > outer_lazy_function->opening_curly_position.offset
+            && candidate.closing_curly_offset < outer_lazy_function->closing_curly_offset) {
+            continue;
+        }
+        outer_lazy_function = &candidate;
+
+        HashTable<FlyString> global_identifier_names;
+        for (auto const& identifier : candidate.free_identifiers) {
+            if (identifier->is_global())
+                global_identifier_names.set(identifier->string());
+        }
+
+        candidate.function.set_lazy_body(make<LazyFunctionBody>(LazyFunctionBody {
+            .source_code = m_source_code,
+            .opening_curly_position = candidate.opening_curly_position,
+            .is_module = m_program_type == Program::Type::Module,
+            .strict_mode = candidate.strict_mode,
+            .global_identifier_names = move(global_identifier_names),
+        }));
+    }
+    m_lazy_function_candidates.clear();
+}
+
+NonnullRefPtr<FunctionBody const> Parser::parse_lazy_function_body(FunctionNode const& function, LazyFunctionBody const& lazy_body)
+{
+    auto program_type = lazy_body.is_module ? Program::Type::Module : Program::Type::Script;
+    auto body_parser = Parser { Lexer { lazy_body.source_code, lazy_body.opening_curly_position }, program_type };
+    body_parser.m_lazy_function_global_identifier_names = &lazy_body.global_identifier_names;
+
+    // NOTE: Private names have already been validated by the initial parse, which knew about the enclosing classes.
+    HashTable<FlyString> referenced_private_names;
+    body_parser.m_state.referenced_private_names = &referenced_private_names;
+    body_parser.m_state.strict_mode = lazy_body.strict_mode;
+    body_parser.m_state.in_function_context = true;
+    body_parser.m_state.in_generator_function_context = function.kind() == FunctionKind::Generator || function.kind() == FunctionKind::AsyncGenerator;
+    body_parser.m_state.await_expression_is_valid = function.kind() == FunctionKind::Async || function.kind() == FunctionKind::AsyncGenerator;
+
+    RefPtr<FunctionBody const> function_body;
+    FunctionParsingInsights parsing_insights;
+    {
+        auto function_scope = ScopePusher::function_scope(body_parser, function.name_identifier());
+        function_body = body_parser.parse_function_body(function.parameters(), function.kind(), parsing_insights);
+    }
+
+    // The body was fine when we parsed the whole program, so it must be fine on its own as well.
+    VERIFY(!body_parser.has_errors());
+    VERIFY(body_parser.match(TokenType::CurlyClose));
+
+    body_parser.drop_lazy_function_bodies();
+    return function_body.release_nonnull();
+}
+
 Parser Parser::parse_function_body_from_string(ByteString const& body_string, u16 parse_options, NonnullRefPtr<FunctionParameters const> parameters, FunctionKind kind, FunctionParsingInsights& parsing_insights)
 {
     RefPtr<FunctionBody const> function_body;
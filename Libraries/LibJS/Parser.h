@@ -213,6 +213,7 @@ public:
     friend ThrowCompletionOr<GC::Ref<ECMAScriptFunctionObject>> FunctionConstructor::create_dynamic_function(VM&, FunctionObject&, FunctionObject*, FunctionKind, ReadonlySpan<String> parameter_args, String const& body_arg);
 
     static Parser parse_function_body_from_string(ByteString const& body_string, u16 parse_options, NonnullRefPtr<FunctionParameters const>, FunctionKind kind, FunctionParsingInsights&);
+    static NonnullRefPtr<FunctionBody const> parse_lazy_function_body(FunctionNode const&, LazyFunctionBody const&);
 
 private:
     friend class ScopePusher;
@@ -220,6 +221,8 @@ private:
     void parse_script(Program& program, bool starts_in_strict_mode);
     void parse_module(Program& program);
 
+    void drop_lazy_function_bodies();
+
     Associativity operator_associativity(TokenType) const;
     bool match_expression() const;
     bool match_unary_prefixed_expression() const;
@@ -335,11 +338,23 @@ private:
 
     [[nodiscard]] NonnullRefPtr<Identifier const> create_identifier_and_register_in_current_scope(SourceRange range, FlyString string, Optional<DeclarationKind> = {});
 
+    // A function whose body we may drop after parsing the whole program, see drop_lazy_function_bodies().
+    struct LazyFunctionCandidate {
+        NonnullRefPtr<ASTNode const> node;
+        FunctionNode const& function;
+        Position opening_curly_position;
+        size_t closing_curly_offset { 0 };
+        bool strict_mode { false };
+        Vector<NonnullRefPtr<Identifier const>> free_identifiers;
+    };
+
     NonnullRefPtr<SourceCode const> m_source_code;
     Vector<Position> m_rule_starts;
     ParserState m_state;
     Vector<ParserState> m_saved_state;
     HashMap<size_t, TokenMemoization> m_token_memoizations;
     Program::Type m_program_type;
+    Vector<LazyFunctionCandidate> m_lazy_function_candidates;
+    HashTable<FlyString> const* m_lazy_function_global_identifier_names { nullptr };
 };
 }
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/ProgramCache.h>
+#include <LibJS/SourceCode.h>
+
+namespace JS {
+
+// NOTE: Executables are generated lazily, as functions are first called, so this grows while the program is cached.
+static size_t memory_usage_of_program(Program const& program)
+{
+    auto const& source_code = program.source_code();
+    return source_code.code().bytes().size() + program.ast_memory_usage() + source_code.executable_memory_usage();
+}
+
+void ProgramCache::set_capacity_in_bytes(size_t capacity)
+{
+    m_capacity_in_bytes = capacity;
+    evict_until_size_is_at_most(capacity);
+}
+
+RefPtr<Program> ProgramCache::find(StringView source_text, StringView filename, size_t line_number_offset, Program::Type type)
+{
+    if (m_least_recently_used.is_empty())
+        return nullptr;
+
+    auto source_hash = source_text.hash();
+    auto bucket = m_entries_by_source_hash.find(source_hash);
+    if (bucket == m_entries_by_source_hash.end())
+        return nullptr;
+
+    for (auto& entry : bucket->value) {
+        auto const& source_code = entry.program->source_code();
+        if (entry.line_number_offset != line_number_offset || entry.program->type() != type)
+            continue;
+        if (source_code.filename() != filename)
+            continue;
+        // NOTE: We compare the full source text rather than trusting the hash, since a false positive would run the wrong code.
+        if (source_code.code().bytes_as_string_view() != source_text)
+            continue;
+
+        NonnullRefPtr program = entry.program;
+
+        // The cached program may have generated more bytecode since we last looked.
+        auto size = memory_usage_of_program(program);
+        m_size_in_bytes = m_size_in_bytes - entry.size_in_bytes + size;
+        entry.size_in_bytes = size;
+
+        m_least_recently_used.remove(program.ptr());
+        m_least_recently_used.set(program.ptr(), source_hash);
+
+        evict_until_size_is_at_most(m_capacity_in_bytes);
+        return program;
+    }
+    return nullptr;
+}
+
+void ProgramCache::add(NonnullRefPtr<Program> program, size_t line_number_offset)
+{
+    auto size = memory_usage_of_program(program);
+    if (size > m_capacity_in_bytes)
+        return;
+
+    evict_until_size_is_at_most(m_capacity_in_bytes - size);
+
+    auto source_hash = program->source_code().code().bytes_as_string_view().hash();
+    m_least_recently_used.set(program.ptr(), source_hash);
+    m_entries_by_source_hash.ensure(source_hash).append({ move(program), line_number_offset, size });
+    m_size_in_bytes += size;
+}
+
+bool ProgramCache::contains(Program const& program) const
+{
+    return m_least_recently_used.contains(&program);
+}
+
+void ProgramCache::clear()
+{
+    m_least_recently_used.clear();
+    m_entries_by_source_hash.clear();
+    m_size_in_bytes = 0;
+}
+
+void ProgramCache::remove(Program const& program, unsigned source_hash)
+{
+    auto bucket = m_entries_by_source_hash.find(source_hash);
+    VERIFY(bucket != m_entries_by_source_hash.end());
+
+    auto index = bucket->value.find_first_index_if([&](auto const& entry) { return entry.program.ptr() == &program; });
+    VERIFY(index.has_value());
+    m_size_in_bytes -= bucket->value[*index].size_in_bytes;
+
+    bucket->value.remove(*index);
+    if (bucket->value.is_empty())
+        m_entries_by_source_hash.remove(bucket);
+}
+
+void ProgramCache::evict_until_size_is_at_most(size_t size)
+{
+    while (m_size_in_bytes > size) {
+        auto least_recently_used = m_least_recently_used.begin();
+        auto const* program = least_recently_used->key;
+        auto source_hash = least_recently_used->value;
+        m_least_recently_used.remove(least_recently_used);
+        remove(*program, source_hash);
+    }
+}
+
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibJS/AST.h>
+
+namespace JS {
+
+// Keeps the ASTs of recently parsed scripts and modules around, so that evaluating the exact same source text again
+// (e.g. the same framework bundle on every navigation) can skip lexing, parsing, and (since function bodies cache their
+// executables on the AST) bytecode generation.
+//
+// The cache is bounded by an estimate of the memory each entry keeps alive: the source text, the AST, and every
+// executable generated from it so far.
+//
+// NOTE: The cached ASTs hold roots to executables on this VM's heap, so a cache must never be shared between VMs.
+//       Within a VM, the executables are shared between realms, so their caches must not assume a single realm.
+class ProgramCache {
+    AK_MAKE_NONCOPYABLE(ProgramCache);
+    AK_MAKE_NONMOVABLE(ProgramCache);
+
+public:
+    ProgramCache() = default;
+
+    // A capacity of 0 (the default) disables the cache.
+    void set_capacity_in_bytes(size_t);
+    size_t capacity_in_bytes() const { return m_capacity_in_bytes; }
+    size_t size_in_bytes() const { return m_size_in_bytes; }
+
+    RefPtr<Program> find(StringView source_text, StringView filename, size_t line_number_offset, Program::Type);
+    void add(NonnullRefPtr<Program>, size_t line_number_offset);
+    bool contains(Program const&) const;
+
+    void clear();
+
+private:
+    struct Entry {
+        NonnullRefPtr<Program> program;
+        size_t line_number_offset { 0 };
+        // The memory usage this entry is currently accounted for in m_size_in_bytes.
+        size_t size_in_bytes { 0 };
+    };
+
+    void evict_until_size_is_at_most(size_t);
+    void remove(Program const&, unsigned source_hash);
+
+    // Keyed by the hash of the source text. Entries with the same source (e.g. under different filenames) share a bucket.
+    HashMap<unsigned, Vector<Entry, 1>> m_entries_by_source_hash;
+
+    // The source hash of every cached program, ordered from least to most recently used.
+    OrderedHashMap<Program const*, unsigned> m_least_recently_used;
+
+    size_t m_size_in_bytes { 0 };
+    size_t m_capacity_in_bytes { 0 };
+};
+
+}
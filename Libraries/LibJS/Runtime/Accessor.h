@@ -24,10 +24,10 @@ public:
     }
 
     FunctionObject* getter() const { return m_getter; }
-    void set_getter(FunctionObject* getter) { m_getter = getter; }
+    void set_getter(FunctionObject* getter) { store_edge(m_getter, getter); }
 
     FunctionObject* setter() const { return m_setter; }
-    void set_setter(FunctionObject* setter) { m_setter = setter; }
+    void set_setter(FunctionObject* setter) { store_edge(m_setter, setter); }
 
     void visit_edges(Cell::Visitor& visitor) override
     {
@@ -41,6 +41,7 @@ private:
         : m_getter(getter)
         , m_setter(setter)
     {
+        enable_write_barrier();
     }
 
     GC::Ptr<FunctionObject> m_getter;
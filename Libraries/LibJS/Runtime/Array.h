@@ -73,6 +73,10 @@ enum class Holes {
     ReadThroughHoles,
 };
 
+// Returns the object's elements if every index below `length` is an own data property kept in simple storage.
+// HasProperty() and Get() on those indices can then neither run user code nor reach the prototype chain.
+SimpleIndexedPropertyStorage const* packed_elements(Object const&, size_t length);
+
 ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes);
 ThrowCompletionOr<double> compare_array_elements(VM&, Value x, Value y, FunctionObject* comparefn);
 
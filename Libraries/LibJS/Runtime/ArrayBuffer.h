@@ -47,11 +47,19 @@ struct DataBlock {
         return byte_buffer.visit(
             [](Empty) -> size_t { return 0u; },
             [](ByteBuffer const& buffer) { return buffer.size(); },
-            [](ByteBuffer const* buffer) { return buffer->size(); });
+            [&](ByteBuffer const* buffer) { return fixed_size.value_or(buffer->size()); });
     }
 
+    // The block's contents, which may be shorter than the underlying buffer (see fixed_size below).
+    Bytes bytes() { return buffer().bytes().trim(size()); }
+    ReadonlyBytes bytes() const { return buffer().bytes().trim(size()); }
+
     Variant<Empty, ByteBuffer, ByteBuffer*> byte_buffer;
     Shared is_shared = { Shared::No };
+
+    // Memory owned elsewhere (e.g. by a shared WebAssembly.Memory) may grow after a buffer was created for it.
+    // If set, the buffer keeps this length regardless.
+    Optional<size_t> fixed_size {};
 };
 
 class ArrayBuffer : public Object {
@@ -71,6 +79,10 @@ public:
     ByteBuffer& buffer() { return m_data_block.buffer(); }
     ByteBuffer const& buffer() const { return m_data_block.buffer(); }
 
+    // [[ArrayBufferData]], limited to [[ArrayBufferByteLength]]
+    Bytes bytes() { return m_data_block.bytes(); }
+    ReadonlyBytes bytes() const { return m_data_block.bytes(); }
+
     // [[ArrayBufferMaxByteLength]]
     size_t max_byte_length() const { return m_max_byte_length.value(); }
     void set_max_byte_length(size_t max_byte_length) { m_max_byte_length = max_byte_length; }
@@ -266,7 +278,7 @@ Value ArrayBuffer::get_value(size_t byte_index, [[maybe_unused]] bool is_typed_a
     VERIFY(!is_detached());
 
     // 2. Assert: There are sufficient bytes in arrayBuffer starting at byteIndex to represent a value of type.
-    VERIFY(m_data_block.buffer().bytes().slice(byte_index).size() >= sizeof(T));
+    VERIFY(m_data_block.bytes().slice(byte_index).size() >= sizeof(T));
 
     // 3. Let block be arrayBuffer.[[ArrayBufferData]].
     auto& block = m_data_block.buffer();
@@ -384,7 +396,7 @@ void ArrayBuffer::set_value(size_t byte_index, Value value, [[maybe_unused]] boo
     VERIFY(!is_detached());
 
     // 2. Assert: There are sufficient bytes in arrayBuffer starting at byteIndex to represent a value of type.
-    VERIFY(m_data_block.buffer().bytes().slice(byte_index).size() >= sizeof(T));
+    VERIFY(m_data_block.bytes().slice(byte_index).size() >= sizeof(T));
 
     // 3. Assert: value is a BigInt if IsBigIntElementType(type) is true; otherwise, value is a Number.
     if constexpr (IsIntegral<T> && sizeof(T) == 8)
@@ -432,9 +444,9 @@ Value ArrayBuffer::get_modify_set_value(size_t byte_index, Value value, ReadWrit
     // FIXME: Check for shared buffer
 
     auto raw_bytes_read = MUST(ByteBuffer::create_uninitialized(sizeof(T)));
-    m_data_block.buffer().bytes().slice(byte_index, sizeof(T)).copy_to(raw_bytes_read);
+    m_data_block.bytes().slice(byte_index, sizeof(T)).copy_to(raw_bytes_read);
     auto raw_bytes_modified = operation(raw_bytes_read, raw_bytes);
-    raw_bytes_modified.span().copy_to(m_data_block.buffer().span().slice(byte_index));
+    raw_bytes_modified.span().copy_to(m_data_block.bytes().slice(byte_index));
 
     return raw_bytes_to_numeric<T>(vm, raw_bytes_read, is_little_endian);
 }
@@ -145,6 +145,57 @@ static ThrowCompletionOr<Object*> array_species_create(VM& vm, Object& original_
     return TRY(construct(vm, constructor.as_function(), Value(length))).ptr();
 }
 
+enum class SearchDirection {
+    Forward,
+    Backward,
+};
+
+enum class SearchEquality {
+    IsStrictlyEqual,
+    SameValueZero,
+};
+
+// Returns the first index in [from, to) (or the last one, when searching backward) whose packed element matches `search_element`.
+static Optional<size_t> search_packed_elements(SimpleIndexedPropertyStorage const& storage, Value search_element, size_t from, size_t to, SearchDirection direction, SearchEquality equality)
+{
+    auto const* elements = storage.elements().data();
+
+    auto search = [&](auto matches) -> Optional<size_t> {
+        if (direction == SearchDirection::Forward) {
+            for (size_t k = from; k < to; ++k) {
+                if (matches(elements[k]))
+                    return k;
+            }
+        } else {
+            for (size_t k = to; k > from; --k) {
+                if (matches(elements[k - 1]))
+                    return k - 1;
+            }
+        }
+        return {};
+    };
+
+    auto kind = storage.element_kind();
+    if (kind == SimpleIndexedPropertyStorage::ElementKind::PackedInt32 || kind == SimpleIndexedPropertyStorage::ElementKind::PackedNumber) {
+        // Only a number can match a number, and both comparisons treat +0 and -0 as equal.
+        if (!search_element.is_number())
+            return {};
+        if (search_element.is_nan()) {
+            if (equality == SearchEquality::IsStrictlyEqual || kind == SimpleIndexedPropertyStorage::ElementKind::PackedInt32)
+                return {};
+            return search([](Value element) { return element.is_nan(); });
+        }
+        auto needle = search_element.as_double();
+        if (kind == SimpleIndexedPropertyStorage::ElementKind::PackedInt32)
+            return search([needle](Value element) { return element.as_i32() == needle; });
+        return search([needle](Value element) { return element.as_double() == needle; });
+    }
+
+    if (equality == SearchEquality::IsStrictlyEqual)
+        return search([&](Value element) { return is_strictly_equal(search_element, element); });
+    return search([&](Value element) { return same_value_zero(element, search_element); });
+}
+
 // 23.1.3.1 Array.prototype.at ( index ), https://tc39.es/ecma262/#sec-array.prototype.at
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::at)
 {
@@ -379,6 +430,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::fill)
     else
         to = min(relative_end, length);
 
+    // OPTIMIZATION: Overwriting packed elements can't run user code, so skip the generic [[Set]].
+    if (packed_elements(this_object, to)) {
+        for (u64 i = from; i < to; i++)
+            this_object->indexed_properties().put(i, vm.argument(0));
+        return this_object;
+    }
+
     for (u64 i = from; i < to; i++)
         TRY(this_object->set(i, vm.argument(0), Object::ShouldThrowExceptions::Yes));
 
@@ -700,13 +758,17 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::for_each)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // OPTIMIZATION: Packed elements are always present and can be read directly. The callback may change
+        //               the array, so this has to be checked again on every iteration.
+        auto const* storage = packed_elements(object, k + 1);
+
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
+        auto k_present = storage || TRY(object->has_property(property_key));
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
+            auto k_value = storage ? storage->elements()[k] : TRY(object->get(property_key));
 
             // ii. Perform ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
             TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
@@ -742,6 +804,11 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = from_argument;
     }
     auto value_to_find = vm.argument(0);
+
+    // OPTIMIZATION: Reading packed elements is unobservable, so search them directly.
+    if (auto const* storage = packed_elements(this_object, length))
+        return Value(search_packed_elements(*storage, value_to_find, from_index, length, SearchDirection::Forward, SearchEquality::SameValueZero).has_value());
+
     for (u64 i = from_index; i < length; ++i) {
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
@@ -795,6 +862,12 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // OPTIMIZATION: Packed elements are all present and reading them is unobservable, so search them directly.
+    if (auto const* storage = packed_elements(object, length)) {
+        auto index = search_packed_elements(*storage, search_element, k, length, SearchDirection::Forward, SearchEquality::IsStrictlyEqual);
+        return index.has_value() ? Value(*index) : Value(-1);
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -906,6 +979,12 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::last_index_of)
         k = (double)length + n;
     }
 
+    // OPTIMIZATION: Packed elements are all present and reading them is unobservable, so search them directly.
+    if (auto const* storage = packed_elements(object, length); storage && k >= 0) {
+        auto index = search_packed_elements(*storage, search_element, 0, k + 1, SearchDirection::Backward, SearchEquality::IsStrictlyEqual);
+        return index.has_value() ? Value(*index) : Value(-1);
+    }
+
     // 8. Repeat, while k ≥ 0,
     for (; k >= 0; --k) {
         auto property_key = PropertyKey { k };
@@ -958,13 +1037,17 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // OPTIMIZATION: Packed elements are always present and can be read directly. The callback may change
+        //               the array, so this has to be checked again on every iteration.
+        auto const* storage = packed_elements(object, k + 1);
+
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
+        auto k_present = storage || TRY(object->has_property(property_key));
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
+            auto k_value = storage ? storage->elements()[k] : TRY(object->get(property_key));
 
             // ii. Let mappedValue be ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
             auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
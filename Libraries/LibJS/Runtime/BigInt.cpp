@@ -21,6 +21,8 @@ GC::Ref<BigInt> BigInt::create(VM& vm, Crypto::SignedBigInteger big_integer)
 BigInt::BigInt(Crypto::SignedBigInteger big_integer)
     : m_big_integer(move(big_integer))
 {
+    // NOTE: BigInts have no edges to other cells.
+    enable_write_barrier();
 }
 
 ErrorOr<String> BigInt::to_string() const
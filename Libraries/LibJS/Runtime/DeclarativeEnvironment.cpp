@@ -13,7 +13,7 @@
 
 namespace JS {
 
-GC_DEFINE_ALLOCATOR(DeclarativeEnvironment);
+GC_DEFINE_LAZILY_SWEPT_ALLOCATOR(DeclarativeEnvironment);
 
 DeclarativeEnvironment* DeclarativeEnvironment::create_for_per_iteration_bindings(Badge<ForStatement>, DeclarativeEnvironment& other, size_t bindings_size)
 {
@@ -23,16 +23,26 @@ DeclarativeEnvironment* DeclarativeEnvironment::create_for_per_iteration_binding
     return parent_environment->heap().allocate<DeclarativeEnvironment>(parent_environment, bindings);
 }
 
+u64 DeclarativeEnvironment::next_environment_serial_number()
+{
+    // NOTE: Executables (and their global variable caches) may be shared between realms, so a serial number must
+    //       never be reused by a different environment. Zero is never handed out, since that's what caches start with.
+    static thread_local u64 s_next_environment_serial_number = 0;
+    return ++s_next_environment_serial_number;
+}
+
 DeclarativeEnvironment::DeclarativeEnvironment()
     : Environment(nullptr, IsDeclarative::Yes)
     , m_dispose_capability(new_dispose_capability())
 {
+    enable_write_barrier();
 }
 
 DeclarativeEnvironment::DeclarativeEnvironment(Environment* parent_environment)
     : Environment(parent_environment, IsDeclarative::Yes)
     , m_dispose_capability(new_dispose_capability())
 {
+    enable_write_barrier();
 }
 
 DeclarativeEnvironment::DeclarativeEnvironment(Environment* parent_environment, ReadonlySpan<Binding> bindings)
@@ -40,6 +50,7 @@ DeclarativeEnvironment::DeclarativeEnvironment(Environment* parent_environment,
     , m_bindings(bindings)
     , m_dispose_capability(new_dispose_capability())
 {
+    enable_write_barrier();
 }
 
 void DeclarativeEnvironment::visit_edges(Visitor& visitor)
@@ -79,7 +90,7 @@ ThrowCompletionOr<void> DeclarativeEnvironment::create_mutable_binding(VM&, FlyS
         .initialized = false,
     });
 
-    ++m_environment_serial_number;
+    m_environment_serial_number = next_environment_serial_number();
 
     // 3. Return unused.
     return {};
@@ -102,7 +113,7 @@ ThrowCompletionOr<void> DeclarativeEnvironment::create_immutable_binding(VM&, Fl
         .initialized = false,
     });
 
-    ++m_environment_serial_number;
+    m_environment_serial_number = next_environment_serial_number();
 
     // 3. Return unused.
     return {};
@@ -124,10 +135,11 @@ ThrowCompletionOr<void> DeclarativeEnvironment::initialize_binding_direct(VM& vm
 
     // 2. If hint is not normal, perform ? AddDisposableResource(envRec.[[DisposeCapability]], V, hint).
     if (hint != Environment::InitializeBindingHint::Normal)
-        TRY(add_disposable_resource(vm, m_dispose_capability, value, hint));
+        TRY(add_disposable_resource(vm, dispose_capability(), value, hint));
 
     // 3. Set the bound value for N in envRec to V.
     binding.value = value;
+    write_barrier(value);
 
     // 4. Record that the binding for N in envRec has been initialized.
     binding.initialized = true;
@@ -178,6 +190,7 @@ ThrowCompletionOr<void> DeclarativeEnvironment::set_mutable_binding_direct(VM& v
 
     if (binding.mutable_) {
         binding.value = value;
+        write_barrier(value);
     } else {
         if (strict)
             return vm.throw_completion<TypeError>(ErrorType::InvalidAssignToConst);
@@ -212,7 +225,7 @@ ThrowCompletionOr<bool> DeclarativeEnvironment::delete_binding(VM&, FlyString co
     // NOTE: We keep the entries in m_bindings to avoid disturbing indices.
     binding_and_index->binding() = {};
 
-    ++m_environment_serial_number;
+    m_environment_serial_number = next_environment_serial_number();
 
     // 4. Return true.
     return true;
@@ -68,10 +68,17 @@ public:
         m_bindings.ensure_capacity(needed_capacity);
     }
 
+    // Changes whenever a binding is added or removed. Serial numbers are unique across all environments (on this
+    // thread), so a cached serial number also identifies the environment it was taken from.
     [[nodiscard]] u64 environment_serial_number() const { return m_environment_serial_number; }
 
     DisposeCapability const& dispose_capability() const { return m_dispose_capability; }
-    DisposeCapability& dispose_capability() { return m_dispose_capability; }
+    // NOTE: Anything may be stored through the returned reference, so don't hold on to it across an allocation.
+    DisposeCapability& dispose_capability()
+    {
+        write_barrier_for_unknown_value();
+        return m_dispose_capability;
+    }
 
 private:
     ThrowCompletionOr<Value> get_binding_value_direct(VM&, Binding const&) const;
@@ -124,11 +131,13 @@ protected:
     }
 
 private:
+    static u64 next_environment_serial_number();
+
     Vector<Binding> m_bindings;
     HashMap<FlyString, size_t> m_bindings_assoc;
     DisposeCapability m_dispose_capability;
 
-    u64 m_environment_serial_number { 0 };
+    u64 m_environment_serial_number { next_environment_serial_number() };
 };
 
 inline ThrowCompletionOr<Value> DeclarativeEnvironment::get_binding_value_direct(VM& vm, size_t index) const
@@ -67,6 +67,13 @@ protected:
 
     virtual void visit_edges(Visitor&) override;
 
+    using Cell::write_barrier;
+    ALWAYS_INLINE void write_barrier(Value value)
+    {
+        if (value.is_cell())
+            write_barrier(&value.as_cell());
+    }
+
 private:
     bool m_permanently_screwed_by_eval { false };
     bool m_declarative { false };
@@ -11,7 +11,7 @@
 
 namespace JS {
 
-GC_DEFINE_ALLOCATOR(FunctionEnvironment);
+GC_DEFINE_LAZILY_SWEPT_ALLOCATOR(FunctionEnvironment);
 
 FunctionEnvironment::FunctionEnvironment(Environment* parent_environment)
     : DeclarativeEnvironment(parent_environment)
@@ -26,6 +26,11 @@ void FunctionEnvironment::visit_edges(Visitor& visitor)
     visitor.visit(m_function_object);
 }
 
+void FunctionEnvironment::set_function_object(ECMAScriptFunctionObject& function)
+{
+    store_edge(m_function_object, &function);
+}
+
 // 9.1.1.3.5 GetSuperBase ( ), https://tc39.es/ecma262/#sec-getsuperbase
 ThrowCompletionOr<Value> FunctionEnvironment::get_super_base() const
 {
@@ -90,6 +95,7 @@ ThrowCompletionOr<Value> FunctionEnvironment::bind_this_value(VM& vm, Value this
 
     // 3. Set envRec.[[ThisValue]] to V.
     m_this_value = this_value;
+    write_barrier(this_value);
 
     // 4. Set envRec.[[ThisBindingStatus]] to initialized.
     m_this_binding_status = ThisBindingStatus::Initialized;
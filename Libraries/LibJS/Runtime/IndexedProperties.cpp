@@ -18,6 +18,22 @@ SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initi
     , m_array_size(initial_values.size())
     , m_packed_elements(move(initial_values))
 {
+    for (auto value : m_packed_elements)
+        update_element_kind(value);
+}
+
+void SimpleIndexedPropertyStorage::update_element_kind(Value value)
+{
+    auto kind = [&] {
+        if (value.is_int32())
+            return ElementKind::PackedInt32;
+        if (value.is_number())
+            return ElementKind::PackedNumber;
+        if (value.is_special_empty_value() || value.is_accessor())
+            return ElementKind::Holey;
+        return ElementKind::Packed;
+    }();
+    m_element_kind = max(m_element_kind, kind);
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
@@ -48,16 +64,20 @@ void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttribute
     VERIFY(attributes == default_attributes);
 
     if (index >= m_array_size) {
+        if (index > m_array_size)
+            m_element_kind = ElementKind::Holey;
         m_array_size = index + 1;
         grow_storage_if_needed();
     }
     m_packed_elements[index] = value;
+    update_element_kind(value);
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
 {
     VERIFY(index < m_array_size);
     m_packed_elements[index] = js_special_empty_value();
+    m_element_kind = ElementKind::Holey;
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_first()
@@ -76,6 +96,8 @@ ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 
 bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
+    if (new_size > m_array_size)
+        m_element_kind = ElementKind::Holey;
     m_array_size = new_size;
     m_packed_elements.resize_with_default_value_and_keep_capacity(new_size, js_special_empty_value());
     return true;
@@ -78,6 +78,19 @@ public:
 
     Vector<Value> const& elements() const { return m_packed_elements; }
 
+    // What the elements below array_like_size() are known to be. Kinds only ever move towards the more
+    // general ones further down this list, never back, so checking the kind once before a loop is enough.
+    enum class ElementKind : u8 {
+        PackedInt32,
+        PackedNumber,
+        Packed,
+        // There may be holes or accessors.
+        Holey,
+    };
+
+    ElementKind element_kind() const { return m_element_kind; }
+    bool is_packed() const { return m_element_kind != ElementKind::Holey; }
+
     [[nodiscard]] bool inline_has_index(u32 index) const
     {
         return index < m_array_size && !m_packed_elements.data()[index].is_special_empty_value();
@@ -94,9 +107,11 @@ private:
     friend GenericIndexedPropertyStorage;
 
     void grow_storage_if_needed();
+    void update_element_kind(Value);
 
     size_t m_array_size { 0 };
     Vector<Value> m_packed_elements;
+    ElementKind m_element_kind { ElementKind::PackedInt32 };
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
@@ -30,11 +30,17 @@ static HashMap<GC::Ptr<Object const>, HashMap<FlyString, Object::IntrinsicAccess
 // 10.1.12 OrdinaryObjectCreate ( proto [ , additionalInternalSlotsList ] ), https://tc39.es/ecma262/#sec-ordinaryobjectcreate
 GC::Ref<Object> Object::create(Realm& realm, Object* prototype)
 {
+    GC::Ptr<Object> object;
     if (!prototype)
-        return realm.create<Object>(realm.intrinsics().empty_object_shape());
-    if (prototype == realm.intrinsics().object_prototype())
-        return realm.create<Object>(realm.intrinsics().new_object_shape());
-    return realm.create<Object>(ConstructWithPrototypeTag::Tag, *prototype);
+        object = realm.create<Object>(realm.intrinsics().empty_object_shape());
+    else if (prototype == realm.intrinsics().object_prototype())
+        object = realm.create<Object>(realm.intrinsics().new_object_shape());
+    else
+        object = realm.create<Object>(ConstructWithPrototypeTag::Tag, *prototype);
+
+    // NOTE: Subclasses have edges of their own, so only objects that are exactly an Object opt into the write barrier.
+    object->enable_write_barrier();
+    return *object;
 }
 
 GC::Ref<Object> Object::create_prototype(Realm& realm, Object* prototype)
@@ -42,12 +48,16 @@ GC::Ref<Object> Object::create_prototype(Realm& realm, Object* prototype)
     auto shape = realm.heap().allocate<Shape>(realm);
     if (prototype)
         shape->set_prototype_without_transition(prototype);
-    return realm.create<Object>(shape);
+    auto object = realm.create<Object>(shape);
+    object->enable_write_barrier();
+    return object;
 }
 
 GC::Ref<Object> Object::create_with_premade_shape(Shape& shape)
 {
-    return shape.realm().create<Object>(shape);
+    auto object = shape.realm().create<Object>(shape);
+    object->enable_write_barrier();
+    return object;
 }
 
 Object::Object(GlobalObjectTag, Realm& realm, MayInterfereWithIndexedPropertyAccess may_interfere_with_indexed_property_access)
@@ -99,7 +109,7 @@ void Object::initialize(Realm&)
 
 void Object::unsafe_set_shape(Shape& shape)
 {
-    m_shape = shape;
+    set_shape(shape);
     m_storage.resize(shape.property_count());
 }
 
@@ -542,6 +552,7 @@ ThrowCompletionOr<void> Object::private_field_add(PrivateName const& name, Value
 
     // 4. Append PrivateElement { [[Key]]: P, [[Kind]]: field, [[Value]]: value } to O.[[PrivateElements]].
     m_private_elements->empend(name, PrivateElement::Kind::Field, value);
+    write_barrier(value);
 
     // 5. Return unused.
     return {};
@@ -569,6 +580,7 @@ ThrowCompletionOr<void> Object::private_method_or_accessor_add(PrivateElement el
         m_private_elements = make<Vector<PrivateElement>>();
 
     // 5. Append method to O.[[PrivateElements]].
+    write_barrier(element.value);
     m_private_elements->append(move(element));
 
     // 6. Return unused.
@@ -625,6 +637,7 @@ ThrowCompletionOr<void> Object::private_set(PrivateName const& name, Value value
     if (entry->kind == PrivateElement::Kind::Field) {
         // a. Set entry.[[Value]] to value.
         entry->value = value;
+        write_barrier(value);
         return {};
     }
     // 4. Else if entry.[[Kind]] is method, then
@@ -1169,7 +1182,7 @@ Optional<ValueAndAttributes> Object::storage_get(PropertyKey const& property_key
 
         if (m_has_intrinsic_accessors) {
             if (auto accessor = find_intrinsic_accessor(this, property_key); accessor.has_value())
-                const_cast<Object&>(*this).m_storage[metadata->offset] = (*accessor)(shape().realm());
+                const_cast<Object&>(*this).put_direct(metadata->offset, (*accessor)(shape().realm()));
         }
 
         value = m_storage[metadata->offset];
@@ -1194,6 +1207,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
     if (property_key.is_number()) {
         auto index = property_key.as_number();
         m_indexed_properties.put(index, value, attributes);
+        write_barrier(value);
         return;
     }
 
@@ -1215,6 +1229,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
         else
             set_shape(*m_shape->create_put_transition(property_key_string_or_symbol, attributes));
         m_storage.append(value);
+        write_barrier(value);
         return;
     }
 
@@ -1225,7 +1240,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
             set_shape(*m_shape->create_configure_transition(property_key_string_or_symbol, attributes));
     }
 
-    m_storage[metadata->offset] = value;
+    put_direct(metadata->offset, value);
 }
 
 void Object::storage_delete(PropertyKey const& property_key)
@@ -1244,14 +1259,14 @@ void Object::storage_delete(PropertyKey const& property_key)
     VERIFY(metadata.has_value());
 
     if (m_shape->is_cacheable_dictionary()) {
-        m_shape = m_shape->create_uncacheable_dictionary_transition();
+        set_shape(m_shape->create_uncacheable_dictionary_transition());
     }
     if (m_shape->is_uncacheable_dictionary()) {
         m_shape->remove_property_without_transition(property_key.to_string_or_symbol(), metadata->offset);
         m_storage.remove(metadata->offset);
         return;
     }
-    m_shape = m_shape->create_delete_transition(property_key.to_string_or_symbol());
+    set_shape(m_shape->create_delete_transition(property_key.to_string_or_symbol()));
     m_storage.remove(metadata->offset);
 }
 
@@ -1259,7 +1274,7 @@ void Object::set_prototype(Object* new_prototype)
 {
     if (prototype() == new_prototype)
         return;
-    m_shape = shape().create_prototype_transition(new_prototype);
+    set_shape(shape().create_prototype_transition(new_prototype));
 }
 
 void Object::define_native_accessor(Realm& realm, PropertyKey const& property_key, Function<ThrowCompletionOr<Value>(VM&)> getter, Function<ThrowCompletionOr<Value>(VM&)> setter, PropertyAttributes attribute)
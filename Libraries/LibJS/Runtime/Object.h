@@ -223,11 +223,24 @@ public:
     virtual void visit_edges(Cell::Visitor&) override;
 
     Value get_direct(size_t index) const { return m_storage[index]; }
-    void put_direct(size_t index, Value value) { m_storage[index] = value; }
+    void put_direct(size_t index, Value value)
+    {
+        m_storage[index] = value;
+        write_barrier(value);
+    }
 
     IndexedProperties const& indexed_properties() const { return m_indexed_properties; }
-    IndexedProperties& indexed_properties() { return m_indexed_properties; }
-    void set_indexed_property_elements(Vector<Value>&& values) { m_indexed_properties = IndexedProperties(move(values)); }
+    // NOTE: Anything may be stored through the returned reference, so don't hold on to it across an allocation.
+    IndexedProperties& indexed_properties()
+    {
+        write_barrier_for_unknown_value();
+        return m_indexed_properties;
+    }
+    void set_indexed_property_elements(Vector<Value>&& values)
+    {
+        m_indexed_properties = IndexedProperties(move(values));
+        write_barrier_for_unknown_value();
+    }
 
     Shape& shape() { return *m_shape; }
     Shape const& shape() const { return *m_shape; }
@@ -259,6 +272,13 @@ protected:
 
     void unsafe_set_shape(Shape&);
 
+    using Cell::write_barrier;
+    ALWAYS_INLINE void write_barrier(Value value)
+    {
+        if (value.is_cell())
+            write_barrier(&value.as_cell());
+    }
+
     // [[Extensible]]
     bool m_is_extensible { true };
 
@@ -270,7 +290,7 @@ protected:
     bool m_is_typed_array { false };
 
 private:
-    void set_shape(Shape& shape) { m_shape = &shape; }
+    void set_shape(Shape& shape) { store_edge(m_shape, &shape); }
 
     Object* prototype() { return shape().prototype(); }
 
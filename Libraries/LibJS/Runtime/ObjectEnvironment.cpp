@@ -18,6 +18,7 @@ ObjectEnvironment::ObjectEnvironment(Object& binding_object, IsWithEnvironment i
     , m_binding_object(binding_object)
     , m_with_environment(is_with_environment == IsWithEnvironment::Yes)
 {
+    enable_write_barrier();
 }
 
 void ObjectEnvironment::visit_edges(Cell::Visitor& visitor)
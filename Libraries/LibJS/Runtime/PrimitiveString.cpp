@@ -27,6 +27,8 @@ RopeString::RopeString(GC::Ref<PrimitiveString> lhs, GC::Ref<PrimitiveString> rh
     , m_lhs(lhs)
     , m_rhs(rhs)
 {
+    // NOTE: The rope halves are only ever assigned here, and later cleared when the rope is resolved.
+    enable_write_barrier();
 }
 
 RopeString::~RopeString() = default;
@@ -34,11 +36,13 @@ RopeString::~RopeString() = default;
 PrimitiveString::PrimitiveString(String string)
     : m_utf8_string(move(string))
 {
+    enable_write_barrier();
 }
 
 PrimitiveString::PrimitiveString(Utf16String string)
     : m_utf16_string(move(string))
 {
+    enable_write_barrier();
 }
 
 PrimitiveString::~PrimitiveString()
@@ -186,7 +186,7 @@ RegExpObject::RegExpObject(Regex<ECMA262> regex, String pattern, String flags, O
     , m_flag_bits(to_flag_bits(m_flags))
     , m_regex(move(regex))
 {
-    VERIFY(m_regex->parser_result.error == regex::Error::NoError);
+    VERIFY(m_regex->parser_result->error == regex::Error::NoError);
 }
 
 void RegExpObject::initialize(Realm& realm)
@@ -238,11 +238,11 @@ ThrowCompletionOr<GC::Ref<RegExpObject>> RegExpObject::regexp_initialize(VM& vm,
 
     // 14. If parseResult is a non-empty List of SyntaxError objects, throw a SyntaxError exception.
     Regex<ECMA262> regex(parsed_pattern.to_byte_string(), parsed_flags);
-    if (regex.parser_result.error != regex::Error::NoError)
+    if (regex.parser_result->error != regex::Error::NoError)
         return vm.throw_completion<SyntaxError>(ErrorType::RegExpCompileError, regex.error_string());
 
     // 15. Assert: parseResult is a Pattern Parse Node.
-    VERIFY(regex.parser_result.error == regex::Error::NoError);
+    VERIFY(regex.parser_result->error == regex::Error::NoError);
 
     // 16. Set obj.[[OriginalSource]] to P.
     m_pattern = move(pattern);
@@ -331,6 +331,21 @@ void RegExpObject::visit_edges(JS::Cell::Visitor& visitor)
     visitor.visit(m_realm);
 }
 
+bool RegExpObject::set_last_exec_input(PrimitiveString const& string)
+{
+    auto address = bit_cast<FlatPtr>(&string);
+    auto length = string.length_in_utf16_code_units();
+    auto collection_count = heap().collection_count();
+
+    if (m_last_exec_input_address == address && m_last_exec_input_length == length && m_last_exec_input_collection_count == collection_count)
+        return true;
+
+    m_last_exec_input_address = address;
+    m_last_exec_input_length = length;
+    m_last_exec_input_collection_count = collection_count;
+    return false;
+}
+
 // 22.2.3.1 RegExpCreate ( P, F ), https://tc39.es/ecma262/#sec-regexpcreate
 ThrowCompletionOr<GC::Ref<RegExpObject>> regexp_create(VM& vm, Value pattern, Value flags)
 {
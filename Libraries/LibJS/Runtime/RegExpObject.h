@@ -69,6 +69,9 @@ public:
     void set_legacy_features_enabled(bool legacy_features_enabled) { m_legacy_features_enabled = legacy_features_enabled; }
     void set_realm(Realm& realm) { m_realm = &realm; }
 
+    // Whether `string` is the one passed to the previous RegExpBuiltinExec, remembering it for the next call.
+    bool set_last_exec_input(PrimitiveString const& string);
+
 private:
     RegExpObject(Object& prototype);
     RegExpObject(Regex<ECMA262> regex, String pattern, String flags, Object& prototype);
@@ -83,6 +86,12 @@ private:
     // Note: This is initialized in RegExpAlloc, but will be non-null afterwards
     GC::Ptr<Realm> m_realm; // [[Realm]]
     Optional<Regex<ECMA262>> m_regex;
+
+    // Only the identity of the last input is remembered, so that it doesn't keep a (possibly huge) string alive.
+    // NOTE: A collection may free the string and hand its address to another one, so its count is remembered too.
+    FlatPtr m_last_exec_input_address { 0 };
+    size_t m_last_exec_input_length { 0 };
+    u64 m_last_exec_input_collection_count { 0 };
 };
 
 template<>
@@ -221,6 +221,8 @@ static ThrowCompletionOr<Value> regexp_builtin_exec(VM& vm, RegExpObject& regexp
 
     // 13.b and 13.c
     regex.start_offset = full_unicode ? string->utf16_string_view().code_point_offset_of(last_index) : last_index;
+    // NOTE: Strings are immutable, so searching the same string again lets the matcher reuse what it learned about it.
+    regex.input_unchanged_since_last_match = regexp_object.set_last_exec_input(*string);
     result = regex.match(string->utf16_string_view());
 
     // 13.d and 13.a
@@ -330,7 +332,7 @@ static ThrowCompletionOr<Value> regexp_builtin_exec(VM& vm, RegExpObject& regexp
         // e. If the ith capture of R was defined with a GroupName, then
         if (capture.capture_group_name >= 0) {
             // i. Let s be the CapturingGroupName of the corresponding RegExpIdentifierName.
-            auto group_name = regex.parser_result.bytecode.get_string(capture.capture_group_name);
+            auto group_name = regex.parser_result->bytecode.get_string(capture.capture_group_name);
 
             // ii. Perform ! CreateDataPropertyOrThrow(groups, s, capturedValue).
             MUST(groups_object->create_data_property_or_throw(group_name, captured_value));
@@ -26,7 +26,7 @@ GC::Ref<Shape> Shape::create_cacheable_dictionary_transition()
     auto new_shape = heap().allocate<Shape>(m_realm);
     new_shape->m_dictionary = true;
     new_shape->m_cacheable = true;
-    new_shape->m_prototype = m_prototype;
+    new_shape->store_edge(new_shape->m_prototype, m_prototype.ptr());
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
     ensure_property_table();
     new_shape->ensure_property_table();
@@ -40,7 +40,7 @@ GC::Ref<Shape> Shape::create_uncacheable_dictionary_transition()
     auto new_shape = heap().allocate<Shape>(m_realm);
     new_shape->m_dictionary = true;
     new_shape->m_cacheable = true;
-    new_shape->m_prototype = m_prototype;
+    new_shape->store_edge(new_shape->m_prototype, m_prototype.ptr());
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
     ensure_property_table();
     new_shape->ensure_property_table();
@@ -111,6 +111,7 @@ GC::Ref<Shape> Shape::create_put_transition(StringOrSymbol const& property_key,
         if (!m_forward_transitions)
             m_forward_transitions = make<HashMap<TransitionKey, WeakPtr<Shape>>>();
         m_forward_transitions->set(key, new_shape.ptr());
+        write_barrier(property_key);
     }
     return new_shape;
 }
@@ -126,6 +127,7 @@ GC::Ref<Shape> Shape::create_configure_transition(StringOrSymbol const& property
         if (!m_forward_transitions)
             m_forward_transitions = make<HashMap<TransitionKey, WeakPtr<Shape>>>();
         m_forward_transitions->set(key, new_shape.ptr());
+        write_barrier(property_key);
     }
     return new_shape;
 }
@@ -149,6 +151,7 @@ GC::Ref<Shape> Shape::create_prototype_transition(Object* new_prototype)
 Shape::Shape(Realm& realm)
     : m_realm(realm)
 {
+    enable_write_barrier();
 }
 
 Shape::Shape(Shape& previous_shape, StringOrSymbol const& property_key, PropertyAttributes attributes, TransitionType transition_type)
@@ -160,6 +163,7 @@ Shape::Shape(Shape& previous_shape, StringOrSymbol const& property_key, Property
     , m_attributes(attributes)
     , m_transition_type(transition_type)
 {
+    enable_write_barrier();
 }
 
 Shape::Shape(Shape& previous_shape, StringOrSymbol const& property_key, TransitionType transition_type)
@@ -171,6 +175,7 @@ Shape::Shape(Shape& previous_shape, StringOrSymbol const& property_key, Transiti
     , m_transition_type(transition_type)
 {
     VERIFY(transition_type == TransitionType::Delete);
+    enable_write_barrier();
 }
 
 Shape::Shape(Shape& previous_shape, Object* new_prototype)
@@ -180,6 +185,7 @@ Shape::Shape(Shape& previous_shape, Object* new_prototype)
     , m_property_count(previous_shape.m_property_count)
     , m_transition_type(TransitionType::Prototype)
 {
+    enable_write_barrier();
 }
 
 void Shape::visit_edges(Cell::Visitor& visitor)
@@ -279,6 +285,7 @@ GC::Ref<Shape> Shape::create_delete_transition(StringOrSymbol const& property_ke
     if (!m_delete_transitions)
         m_delete_transitions = make<HashMap<StringOrSymbol, WeakPtr<Shape>>>();
     m_delete_transitions->set(property_key, new_shape.ptr());
+    write_barrier(property_key);
     return new_shape;
 }
 
@@ -324,8 +331,8 @@ GC::Ref<Shape> Shape::create_for_prototype(GC::Ref<Realm> realm, GC::Ptr<Object>
     auto new_shape = realm->heap().allocate<Shape>(realm);
     s_all_prototype_shapes.set(new_shape);
     new_shape->m_is_prototype_shape = true;
-    new_shape->m_prototype = prototype;
-    new_shape->m_prototype_chain_validity = realm->heap().allocate<PrototypeChainValidity>();
+    new_shape->store_edge(new_shape->m_prototype, prototype.ptr());
+    new_shape->store_edge(new_shape->m_prototype_chain_validity, realm->heap().allocate<PrototypeChainValidity>().ptr());
     return new_shape;
 }
 
@@ -336,12 +343,12 @@ GC::Ref<Shape> Shape::clone_for_prototype()
     auto new_shape = heap().allocate<Shape>(m_realm);
     s_all_prototype_shapes.set(new_shape);
     new_shape->m_is_prototype_shape = true;
-    new_shape->m_prototype = m_prototype;
+    new_shape->store_edge(new_shape->m_prototype, m_prototype.ptr());
     ensure_property_table();
     new_shape->ensure_property_table();
     (*new_shape->m_property_table) = *m_property_table;
     new_shape->m_property_count = new_shape->m_property_table->size();
-    new_shape->m_prototype_chain_validity = heap().allocate<PrototypeChainValidity>();
+    new_shape->store_edge(new_shape->m_prototype_chain_validity, heap().allocate<PrototypeChainValidity>().ptr());
     return new_shape;
 }
 
@@ -349,7 +356,7 @@ void Shape::set_prototype_without_transition(Object* new_prototype)
 {
     VERIFY(new_prototype);
     new_prototype->convert_to_prototype_if_needed();
-    m_prototype = new_prototype;
+    store_edge(m_prototype, new_prototype);
 }
 
 void Shape::set_prototype_shape()
@@ -357,7 +364,7 @@ void Shape::set_prototype_shape()
     VERIFY(!m_is_prototype_shape);
     s_all_prototype_shapes.set(this);
     m_is_prototype_shape = true;
-    m_prototype_chain_validity = heap().allocate<PrototypeChainValidity>();
+    store_edge(m_prototype_chain_validity, heap().allocate<PrototypeChainValidity>().ptr());
 }
 
 void Shape::invalidate_prototype_if_needed_for_new_prototype(GC::Ref<Shape> new_prototype_shape)
@@ -388,7 +395,7 @@ void Shape::invalidate_all_prototype_chains_leading_to_this()
         return;
     for (auto* shape : shapes_to_invalidate) {
         shape->m_prototype_chain_validity->set_valid(false);
-        shape->m_prototype_chain_validity = heap().allocate<PrototypeChainValidity>();
+        shape->store_edge(shape->m_prototype_chain_validity, heap().allocate<PrototypeChainValidity>().ptr());
     }
 }
 
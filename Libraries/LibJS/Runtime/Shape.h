@@ -124,6 +124,14 @@ private:
 
     void ensure_property_table() const;
 
+    // NOTE: Only symbol keys are cells. The keys of the property table aren't edges, so they don't need this.
+    using Cell::write_barrier;
+    void write_barrier(StringOrSymbol const& key)
+    {
+        if (key.is_symbol())
+            write_barrier(key.as_symbol());
+    }
+
     GC::Ref<Realm> m_realm;
 
     mutable OwnPtr<OrderedHashMap<StringOrSymbol, PropertyMetadata>> m_property_table;
@@ -17,6 +17,8 @@ Symbol::Symbol(Optional<String> description, bool is_global)
     : m_description(move(description))
     , m_is_global(is_global)
 {
+    // NOTE: Symbols have no edges to other cells.
+    enable_write_barrier();
 }
 
 GC::Ref<Symbol> Symbol::create(VM& vm, Optional<String> description, bool is_global)
@@ -16,6 +16,7 @@
 #include <LibFileSystem/FileSystem.h>
 #include <LibJS/AST.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
@@ -64,12 +65,13 @@ static constexpr auto make_single_ascii_character_strings(IndexSequence<code_poi
 static constexpr auto single_ascii_character_strings = make_single_ascii_character_strings(MakeIndexSequence<128>());
 
 VM::VM(ErrorMessages error_messages)
-    : m_heap(this, [this](HashMap<GC::Cell*, GC::HeapRoot>& roots) {
+    : m_heap(this, [this](GC::HeapRootSet& roots) {
         gather_roots(roots);
     })
     , m_error_messages(move(error_messages))
 {
     m_bytecode_interpreter = make<Bytecode::Interpreter>(*this);
+    m_program_cache = make<ProgramCache>();
 
     m_empty_string = m_heap.allocate<PrimitiveString>(String {});
 
@@ -228,7 +230,7 @@ struct ExecutionContextRootsCollector : public Cell::Visitor {
     HashTable<GC::Ptr<GC::Cell>> roots;
 };
 
-void VM::gather_roots(HashMap<GC::Cell*, GC::HeapRoot>& roots)
+void VM::gather_roots(GC::HeapRootSet& roots)
 {
     roots.set(m_empty_string, GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
     for (auto string : m_single_ascii_character_strings)
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Badge.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 #include <LibJS/Forward.h>
@@ -22,12 +23,19 @@ public:
 
     SourceRange range_from_offsets(u32 start_offset, u32 end_offset) const;
 
+    // The combined memory usage of all live executables generated from this source code.
+    size_t executable_memory_usage() const { return m_executable_memory_usage; }
+    void did_create_executable(Badge<Bytecode::Executable>, size_t memory_usage) const { m_executable_memory_usage += memory_usage; }
+    void did_destroy_executable(Badge<Bytecode::Executable>, size_t memory_usage) const { m_executable_memory_usage -= memory_usage; }
+
 private:
     SourceCode(String filename, String code);
 
     String m_filename;
     String m_code;
 
+    mutable size_t m_executable_memory_usage { 0 };
+
     // For fast mapping of offsets to line/column numbers, we build a list of
     // starting points (with byte offsets into the source string) and which
     // line:column they map to. This can then be binary-searched.
@@ -0,0 +1,102 @@
+describe("searching numeric arrays", () => {
+    test("int32 elements", () => {
+        const array = [1, 2, 3, 2, 1];
+        expect(array.indexOf(2)).toBe(1);
+        expect(array.lastIndexOf(2)).toBe(3);
+        expect(array.indexOf(2.0)).toBe(1);
+        expect(array.indexOf(2.5)).toBe(-1);
+        expect(array.indexOf("2")).toBe(-1);
+        expect(array.indexOf(NaN)).toBe(-1);
+        expect(array.includes(NaN)).toBeFalse();
+        expect(array.indexOf(1, 1)).toBe(4);
+        expect(array.lastIndexOf(1, -2)).toBe(0);
+    });
+
+    test("negative zero", () => {
+        expect([1, 0, 2].indexOf(-0)).toBe(1);
+        expect([1, -0, 2].indexOf(0)).toBe(1);
+        expect([1, 0, 2].includes(-0)).toBeTrue();
+    });
+
+    test("double elements", () => {
+        const array = [1.5, NaN, 2, 3.25];
+        expect(array.indexOf(3.25)).toBe(3);
+        expect(array.indexOf(2)).toBe(2);
+        expect(array.indexOf(NaN)).toBe(-1);
+        expect(array.lastIndexOf(NaN)).toBe(-1);
+        expect(array.includes(NaN)).toBeTrue();
+        expect(array.includes(undefined)).toBeFalse();
+    });
+
+    test("elements become more general after writes", () => {
+        const array = [1, 2, 3];
+        array[1] = "two";
+        expect(array.indexOf("two")).toBe(1);
+        expect(array.indexOf(2)).toBe(-1);
+        array[3] = 4.5;
+        expect(array.indexOf(4.5)).toBe(3);
+    });
+});
+
+describe("holes", () => {
+    test("holes are looked up on the prototype chain", () => {
+        const array = [1, 2, 3];
+        delete array[1];
+        Array.prototype[1] = 2;
+        try {
+            expect(array.indexOf(2)).toBe(1);
+            expect(array.includes(2)).toBeTrue();
+            array.length = 5;
+            Array.prototype[4] = "inherited";
+            expect(array.indexOf("inherited")).toBe(4);
+        } finally {
+            delete Array.prototype[1];
+            delete Array.prototype[4];
+        }
+    });
+
+    test("filling an array with holes", () => {
+        const array = [1, , 3];
+        array.fill(7);
+        expect(array).toEqual([7, 7, 7]);
+        expect(array.indexOf(7, 1)).toBe(1);
+    });
+});
+
+describe("callbacks that change the array", () => {
+    test("forEach sees shrinking arrays", () => {
+        const array = [1, 2, 3, 4];
+        const seen = [];
+        array.forEach(value => {
+            seen.push(value);
+            array.length = 2;
+        });
+        expect(seen).toEqual([1, 2]);
+    });
+
+    test("map sees replaced elements", () => {
+        const array = [1, 2, 3];
+        const result = array.map((value, index) => {
+            if (index === 0) array[2] = "three";
+            return value;
+        });
+        expect(result).toEqual([1, 2, "three"]);
+    });
+
+    test("fill start coercion shrinking the array", () => {
+        const array = [1, 2, 3, 4];
+        array.fill(0, {
+            valueOf() {
+                array.length = 1;
+                return 0;
+            },
+        });
+        expect(array).toEqual([0, 0, 0, 0]);
+    });
+});
+
+test("sorting packed arrays", () => {
+    expect([3, 1, 2].sort()).toEqual([1, 2, 3]);
+    expect([10, 9, 1].sort()).toEqual([1, 10, 9]);
+    expect([3.5, 1, 2].toSorted((a, b) => a - b)).toEqual([1, 2, 3.5]);
+});
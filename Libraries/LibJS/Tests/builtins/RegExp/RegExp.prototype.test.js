@@ -103,3 +103,14 @@ test("property escapes", () => {
     expect(/\p{Any}/u.test("\u0378")).toBeTrue();
     expect(/\p{Assigned}/u.test("\u0378")).toBeFalse();
 });
+
+test("word characters under unicode case folding", () => {
+    expect(/\w/iu.test("\u212A")).toBeTrue();
+    expect(/\w/iu.test("\u017F")).toBeTrue();
+    expect(/\w/iv.test("\u212A")).toBeTrue();
+    expect(/\W/iu.test("\u212A")).toBeFalse();
+    expect("--\u017F".search(/\w/iu)).toBe(2);
+
+    expect(/\w/i.test("\u212A")).toBeFalse();
+    expect(/\w/u.test("\u212A")).toBeFalse();
+});
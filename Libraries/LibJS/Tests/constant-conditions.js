@@ -0,0 +1,51 @@
+test("Constant conditions pick the right branch", () => {
+    let taken = [];
+    if (1) taken.push("number");
+    if ("") taken.push("empty string");
+    if (null ?? true) taken.push("nullish");
+    if (undefined?.foo === undefined) taken.push("optional chain");
+    expect(taken).toEqual(["number", "nullish", "optional chain"]);
+});
+
+test("Constant loop conditions", () => {
+    let iterations = 0;
+    while (1) {
+        if (++iterations === 3) break;
+    }
+    expect(iterations).toBe(3);
+
+    for (;;) {
+        if (++iterations === 5) break;
+    }
+    expect(iterations).toBe(5);
+
+    do {
+        ++iterations;
+    } while (0);
+    expect(iterations).toBe(6);
+});
+
+test("Unreachable code after return and throw inside try/finally", () => {
+    function f() {
+        try {
+            return "try";
+            // eslint-disable-next-line no-unreachable
+            throw new Error("unreachable");
+        } finally {
+            // eslint-disable-next-line no-unsafe-finally
+            if (0) return "finally";
+        }
+    }
+    expect(f()).toBe("try");
+
+    function* g() {
+        while (true) {
+            yield 1;
+            if (true) continue;
+            yield 2;
+        }
+    }
+    let it = g();
+    expect(it.next().value).toBe(1);
+    expect(it.next().value).toBe(1);
+});
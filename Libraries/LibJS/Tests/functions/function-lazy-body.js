@@ -0,0 +1,121 @@
+// NOTE: The bodies of functions nested in other functions are dropped after parsing and parsed again when needed,
+//       so these tests mostly make sure that nothing is lost along the way.
+
+var lazyGlobal = "global";
+
+function outer(parameter) {
+    let captured = parameter * 2;
+
+    function inner(value) {
+        let local = value + captured;
+        const unused = "padding to make this body long enough to be dropped";
+        return `${local} ${lazyGlobal} ${typeof this}`;
+    }
+
+    function innermostHolder() {
+        function innermost(value) {
+            const padding = "padding to make this body long enough to be dropped";
+            return value + captured + padding.length;
+        }
+        return innermost;
+    }
+
+    return { inner, innermostHolder };
+}
+
+test("calling lazily parsed functions", () => {
+    const { inner, innermostHolder } = outer(5);
+    expect(inner(1)).toBe("11 global object");
+    expect(innermostHolder()(1)).toBe(62);
+});
+
+test("lazily parsed functions see later changes to globals and closures", () => {
+    function makeCounter() {
+        let count = 0;
+        function increment(step) {
+            const padding = "padding to make this body long enough to be dropped";
+            count += step;
+            return count + lazyGlobal.length;
+        }
+        return increment;
+    }
+
+    const increment = makeCounter();
+    lazyGlobal = "changed";
+    expect(increment(1)).toBe(8);
+    expect(increment(2)).toBe(10);
+    lazyGlobal = "global";
+});
+
+test("strict mode is inherited by lazily parsed functions", () => {
+    function strictOuter() {
+        "use strict";
+        function strictInner() {
+            const padding = "padding to make this body long enough to be dropped";
+            return this;
+        }
+        return strictInner;
+    }
+
+    function sloppyOuter() {
+        function sloppyInner() {
+            const padding = "padding to make this body long enough to be dropped";
+            return this;
+        }
+        return sloppyInner;
+    }
+
+    expect(strictOuter()()).toBeUndefined();
+    expect(sloppyOuter()()).toBe(globalThis);
+});
+
+test("generators, async functions and recursion", () => {
+    function makeFunctions() {
+        function* generator(limit) {
+            const padding = "padding to make this body long enough to be dropped";
+            for (let i = 0; i < limit; ++i) yield i;
+        }
+        async function asyncFunction(value) {
+            const padding = "padding to make this body long enough to be dropped";
+            return await value;
+        }
+        function factorial(n) {
+            const padding = "padding to make this body long enough to be dropped";
+            return n <= 1 ? 1 : n * factorial(n - 1);
+        }
+        return { generator, asyncFunction, factorial };
+    }
+
+    const { generator, asyncFunction, factorial } = makeFunctions();
+    expect([...generator(3)]).toEqual([0, 1, 2]);
+    expect(factorial(5)).toBe(120);
+
+    let result;
+    asyncFunction(42).then(value => {
+        result = value;
+    });
+    runQueuedPromiseJobs();
+    expect(result).toBe(42);
+});
+
+test("arguments and private names in lazily parsed functions", () => {
+    class Holder {
+        #secret = 42;
+
+        reader() {
+            function read(holder) {
+                const padding = "padding to make this body long enough to be dropped";
+                return holder.#secret + arguments.length;
+            }
+            return read;
+        }
+    }
+
+    expect(new Holder().reader()(new Holder(), 1)).toBe(44);
+});
+
+test("source text of lazily parsed functions", () => {
+    const { inner } = outer(1);
+    expect(inner.toString().includes("padding to make this body long enough to be dropped")).toBeTrue();
+    expect(inner.toString().startsWith("function inner(value) {")).toBeTrue();
+});
@@ -16,3 +16,61 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Polymorphic inline cache keeps per-shape offsets apart", () => {
+    let objects = [{ x: 1 }, { a: 0, x: 2 }, { a: 0, b: 0, x: 3 }, { a: 0, b: 0, c: 0, x: 4 }];
+
+    function get(o) {
+        return o.x;
+    }
+
+    function put(o, value) {
+        o.x = value;
+    }
+
+    for (let i = 0; i < 3; ++i) {
+        for (let j = 0; j < objects.length; ++j) {
+            expect(get(objects[j])).toBe(j + 1);
+            put(objects[j], j + 1);
+        }
+    }
+});
+
+test("Megamorphic inline cache", () => {
+    let objects = [];
+    for (let i = 0; i < 20; ++i) {
+        let o = {};
+        for (let j = 0; j < i; ++j) o["p" + j] = j;
+        o.x = i;
+        objects.push(o);
+    }
+
+    function get(o) {
+        return o.x;
+    }
+
+    function put(o, value) {
+        o.x = value;
+    }
+
+    for (let i = 0; i < 3; ++i) {
+        for (let j = 0; j < objects.length; ++j) {
+            expect(get(objects[j])).toBe(j + i);
+            put(objects[j], j + i + 1);
+        }
+    }
+
+    // A read-only property with a previously seen name must not be written through the megamorphic cache.
+    let frozen = Object.freeze({ x: "frozen" });
+    put(frozen, 1);
+    expect(get(frozen)).toBe("frozen");
+
+    // Prototype chain mutations must still be observed.
+    let proto = { x: "proto" };
+    let inheriting = Object.create(proto);
+    expect(get(inheriting)).toBe("proto");
+    proto.x = "changed";
+    expect(get(inheriting)).toBe("changed");
+    Object.setPrototypeOf(inheriting, { x: "other" });
+    expect(get(inheriting)).toBe("other");
+});
@@ -23,3 +23,46 @@ test("exception in test expression", () => {
         while (foo);
     }).toThrow(ReferenceError);
 });
+
+test("test expression with side effects is evaluated once per iteration", () => {
+    let evaluations = 0;
+    let number = 0;
+    while ((evaluations++, number < 5)) {
+        if (number === 2) {
+            number += 2;
+            continue;
+        }
+        number++;
+    }
+    expect(number).toBe(5);
+    expect(evaluations).toBe(5);
+});
+
+test("exception in test expression inside try block", () => {
+    let caught = null;
+    let number = 0;
+    try {
+        while (number < 3 || foo) {
+            number++;
+        }
+    } catch (e) {
+        caught = e;
+    }
+    expect(number).toBe(3);
+    expect(caught).toBeInstanceOf(ReferenceError);
+});
+
+test("loop body with try block", () => {
+    let number = 0;
+    let caught = 0;
+    while (number < 4) {
+        try {
+            number++;
+            if (number % 2 === 0) throw number;
+        } catch {
+            caught++;
+        }
+    }
+    expect(number).toBe(4);
+    expect(caught).toBe(2);
+});
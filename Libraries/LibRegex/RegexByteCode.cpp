@@ -761,7 +761,8 @@ ALWAYS_INLINE bool OpCode_Compare::compare_string(MatchInput const& input, Match
 
 ALWAYS_INLINE void OpCode_Compare::compare_character_class(MatchInput const& input, MatchState& state, CharClass character_class, u32 ch, bool inverse, bool& inverse_matched)
 {
-    if (matches_character_class(character_class, ch, input.regex_options & AllFlags::Insensitive)) {
+    auto unicode = input.regex_options.has_flag_set(AllFlags::Unicode) || input.regex_options.has_flag_set(AllFlags::UnicodeSets);
+    if (matches_character_class(character_class, ch, input.regex_options & AllFlags::Insensitive, unicode)) {
         if (inverse)
             inverse_matched = true;
         else
@@ -769,7 +770,7 @@ ALWAYS_INLINE void OpCode_Compare::compare_character_class(MatchInput const& inp
     }
 }
 
-bool OpCode_Compare::matches_character_class(CharClass character_class, u32 ch, bool insensitive)
+bool OpCode_Compare::matches_character_class(CharClass character_class, u32 ch, bool insensitive, bool unicode)
 {
     constexpr auto is_space_or_line_terminator = [](u32 code_point) {
         if ((code_point == 0x0a) || (code_point == 0x0d) || (code_point == 0x2028) || (code_point == 0x2029))
@@ -803,6 +804,10 @@ bool OpCode_Compare::matches_character_class(CharClass character_class, u32 ch,
     case CharClass::Upper:
         return is_ascii_upper_alpha(ch) || (insensitive && is_ascii_lower_alpha(ch));
     case CharClass::Word:
+        // With both the unicode and the ignore-case flag, \w also matches what case-folds into it.
+        // https://tc39.es/ecma262/#sec-wordcharacters
+        if (insensitive && unicode && (ch == 0x017f || ch == 0x212a))
+            return true;
         return is_ascii_alphanumeric(ch) || ch == '_';
     case CharClass::Xdigit:
         return is_ascii_hex_digit(ch);
@@ -861,7 +861,7 @@ public:
     ByteString arguments_string() const override;
     Vector<ByteString> variable_arguments_to_byte_string(Optional<MatchInput const&> input = {}) const;
     Vector<CompareTypeAndValuePair> flat_compares() const;
-    static bool matches_character_class(CharClass, u32, bool insensitive);
+    static bool matches_character_class(CharClass, u32, bool insensitive, bool unicode);
 
 private:
     ALWAYS_INLINE static void compare_char(MatchInput const& input, MatchState& state, u32 ch1, bool inverse, bool& inverse_matched);
@@ -23,7 +23,7 @@ public:
     template<typename T>
     void print_raw_bytecode(Regex<T>& regex) const
     {
-        auto& bytecode = regex.parser_result.bytecode;
+        auto& bytecode = regex.parser_result->bytecode;
         size_t index { 0 };
         for (auto& value : bytecode) {
             outln(m_file, "OpCode i={:3} [{:#02X}]", index, value);
@@ -34,7 +34,7 @@ public:
     template<typename T>
     void print_bytecode(Regex<T> const& regex) const
     {
-        print_bytecode(regex.parser_result.bytecode);
+        print_bytecode(regex.parser_result->bytecode);
     }
 
     void print_bytecode(ByteCode const& bytecode) const
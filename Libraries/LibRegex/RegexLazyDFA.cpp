@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <AK/Debug.h>
+#include <AK/QuickSort.h>
+#include <LibRegex/RegexLazyDFA.h>
+
+namespace regex {
+
+enum class CompareShape {
+    SingleCharacter,
+    Literal,
+    Unsupported,
+};
+
+// Single-character compares are evaluated with the real opcode, literal strings are split into one node per character.
+// Anything that may consume more or less than one character per node can't be modelled.
+static CompareShape classify_compare(ByteCode const& bytecode, size_t instruction_position, Vector<u32>& literal)
+{
+    auto argument_count = bytecode.at(instruction_position + 1);
+    size_t offset = instruction_position + 3;
+    for (size_t i = 0; i < argument_count; ++i) {
+        auto compare_type = static_cast<CharacterCompareType>(bytecode.at(offset++));
+        switch (compare_type) {
+        case CharacterCompareType::String: {
+            auto length = bytecode.at(offset++);
+            if (argument_count != 1 || length == 0)
+                return CompareShape::Unsupported;
+            for (size_t k = 0; k < length; ++k) {
+                auto ch = bytecode.at(offset + k);
+                // Non-ASCII characters may span several code units of the input.
+                if (ch >= 0x80)
+                    return CompareShape::Unsupported;
+                literal.append(ch);
+            }
+            return CompareShape::Literal;
+        }
+        case CharacterCompareType::Reference:
+            return CompareShape::Unsupported;
+        case CharacterCompareType::Char:
+        case CharacterCompareType::CharClass:
+        case CharacterCompareType::CharRange:
+        case CharacterCompareType::Property:
+        case CharacterCompareType::GeneralCategory:
+        case CharacterCompareType::Script:
+        case CharacterCompareType::ScriptExtension:
+            ++offset;
+            break;
+        case CharacterCompareType::LookupTable: {
+            auto count = bytecode.at(offset++);
+            offset += count;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return CompareShape::SingleCharacter;
+}
+
+OwnPtr<LazyDFA> LazyDFA::try_create(ByteCode const& bytecode)
+{
+    auto dfa = adopt_own(*new LazyDFA);
+    auto& nodes = dfa->m_nodes;
+
+    HashMap<size_t, u32> node_for_instruction;
+    HashMap<size_t, Vector<u32>> literals;
+
+    // First pass: create a node for every instruction, and one for every character of a literal string.
+    auto state = MatchState::only_for_enumeration();
+    for (state.instruction_position = 0; state.instruction_position < bytecode.size();) {
+        auto& opcode = bytecode.get_opcode(state);
+        auto instruction_position = state.instruction_position;
+        node_for_instruction.set(instruction_position, nodes.size());
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::PopSaved:
+            // Lookarounds.
+            return nullptr;
+        case OpCodeId::Compare: {
+            Vector<u32> literal;
+            switch (classify_compare(bytecode, instruction_position, literal)) {
+            case CompareShape::Unsupported:
+                return nullptr;
+            case CompareShape::SingleCharacter:
+                nodes.append({ .kind = Node::Kind::Compare, .instruction_position = instruction_position });
+                break;
+            case CompareShape::Literal:
+                for (auto ch : literal)
+                    nodes.append({ .kind = Node::Kind::Literal, .literal = ch, .instruction_position = instruction_position });
+                literals.set(instruction_position, move(literal));
+                break;
+            }
+            break;
+        }
+        case OpCodeId::Exit:
+            nodes.append({ .kind = Node::Kind::Accept, .instruction_position = instruction_position });
+            break;
+        default:
+            nodes.append({ .kind = Node::Kind::Epsilon, .instruction_position = instruction_position });
+            break;
+        }
+
+        state.instruction_position += opcode.size();
+    }
+
+    // Running off the end of the bytecode is the same as reaching an Exit.
+    auto end_node = static_cast<u32>(nodes.size());
+    node_for_instruction.set(bytecode.size(), end_node);
+    nodes.append({ .kind = Node::Kind::Accept, .instruction_position = bytecode.size() });
+
+    auto node_for = [&](ssize_t target) -> Optional<u32> {
+        if (target < 0)
+            return {};
+        if (static_cast<size_t>(target) >= bytecode.size())
+            return end_node;
+        return node_for_instruction.get(target);
+    };
+
+    dfa->m_epsilon_predecessors.resize(nodes.size());
+    dfa->m_consuming_predecessors.resize(nodes.size());
+
+    // Second pass: connect the nodes. Anything whose outcome depends on more than the next character
+    // (assertions, repetition counters, checkpoints) is allowed to take every path it could take.
+    for (state.instruction_position = 0; state.instruction_position < bytecode.size();) {
+        auto& opcode = bytecode.get_opcode(state);
+        auto instruction_position = state.instruction_position;
+        auto next_instruction_position = static_cast<ssize_t>(instruction_position + opcode.size());
+        auto node = node_for_instruction.get(instruction_position).value();
+
+        auto add_epsilon = [&](ssize_t target) -> bool {
+            auto target_node = node_for(target);
+            if (!target_node.has_value())
+                return false;
+            dfa->m_epsilon_predecessors[*target_node].append(node);
+            return true;
+        };
+
+        bool ok = true;
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto next = node_for(next_instruction_position).value();
+            if (auto literal = literals.get(instruction_position); literal.has_value()) {
+                for (size_t i = 0; i < literal->size(); ++i) {
+                    auto literal_node = node + static_cast<u32>(i);
+                    nodes[literal_node].next = i + 1 < literal->size() ? literal_node + 1 : next;
+                    dfa->m_consuming_predecessors[nodes[literal_node].next].append(literal_node);
+                }
+            } else {
+                nodes[node].next = next;
+                dfa->m_consuming_predecessors[next].append(node);
+            }
+            break;
+        }
+        case OpCodeId::Exit:
+            break;
+        case OpCodeId::Jump:
+            ok = add_epsilon(next_instruction_position + static_cast<OpCode_Jump const&>(opcode).offset());
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            ok = add_epsilon(next_instruction_position)
+                && add_epsilon(next_instruction_position + static_cast<OpCode_ForkJump const&>(opcode).offset());
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            ok = add_epsilon(next_instruction_position)
+                && add_epsilon(next_instruction_position + static_cast<OpCode_ForkStay const&>(opcode).offset());
+            break;
+        case OpCodeId::JumpNonEmpty:
+            ok = add_epsilon(next_instruction_position)
+                && add_epsilon(next_instruction_position + static_cast<OpCode_JumpNonEmpty const&>(opcode).offset());
+            break;
+        case OpCodeId::Repeat:
+            ok = add_epsilon(next_instruction_position)
+                && add_epsilon(static_cast<ssize_t>(instruction_position - static_cast<OpCode_Repeat const&>(opcode).offset()));
+            break;
+        default:
+            ok = add_epsilon(next_instruction_position);
+            break;
+        }
+        if (!ok)
+            return nullptr;
+
+        state.instruction_position += opcode.size();
+    }
+
+    for (u32 i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].kind == Node::Kind::Accept)
+            dfa->m_accept_nodes.append(i);
+    }
+    dfa->m_start_node = node_for(0).value();
+    dfa->m_marks.resize(nodes.size());
+
+    return dfa;
+}
+
+void LazyDFA::clear_states()
+{
+    m_states_by_nodes.clear();
+    m_states.clear();
+    m_initial_state = nullptr;
+    m_memory_usage = 0;
+}
+
+// Returns the state for every node from which the rest of the input can be matched, given that it can be
+// matched from all of `seeds`: that's the seeds and every node that can reach one of them without consuming input.
+LazyDFA::State* LazyDFA::state_for(Vector<u32>&& seeds)
+{
+    ++m_generation;
+
+    Vector<u32> nodes;
+    bool can_start_match = false;
+    auto visit = [&](u32 node) {
+        if (m_marks[node] == m_generation)
+            return false;
+        m_marks[node] = m_generation;
+        nodes.append(node);
+        can_start_match |= node == m_start_node;
+        return true;
+    };
+
+    Vector<u32> worklist;
+    for (auto seed : seeds) {
+        if (visit(seed))
+            worklist.append(seed);
+    }
+    while (!worklist.is_empty()) {
+        auto node = worklist.take_last();
+        for (auto predecessor : m_epsilon_predecessors[node]) {
+            if (visit(predecessor))
+                worklist.append(predecessor);
+        }
+    }
+
+    quick_sort(nodes);
+
+    if (auto state = m_states_by_nodes.get(nodes); state.has_value())
+        return *state;
+
+    auto state = make<State>();
+    for (auto node : nodes)
+        state->candidates.extend(m_consuming_predecessors[node]);
+    state->can_start_match = can_start_match;
+    state->nodes = nodes;
+
+    m_memory_usage += sizeof(State) + (2 * nodes.size() + state->candidates.size()) * sizeof(u32);
+    if (m_memory_usage > MaxLazyDFAMemoryUsage)
+        return nullptr;
+
+    auto* state_pointer = state.ptr();
+    m_states_by_nodes.set(move(nodes), state_pointer);
+    m_states.append(move(state));
+    return state_pointer;
+}
+
+bool LazyDFA::node_matches(Node const& node, ByteCode const& bytecode, MatchInput const& input, size_t position)
+{
+    if (node.kind == Node::Kind::Literal) {
+        auto ch = input.view.code_unit_at(position);
+        if (input.regex_options & AllFlags::Insensitive) {
+            // Case folding outside of ASCII is left to the backtracker.
+            return ch >= 0x80 || to_ascii_lowercase(ch) == to_ascii_lowercase(node.literal);
+        }
+        return ch == node.literal;
+    }
+
+    VERIFY(node.kind == Node::Kind::Compare);
+    m_scratch_state.instruction_position = node.instruction_position;
+    m_scratch_state.string_position = position;
+    m_scratch_state.string_position_in_code_units = position;
+    auto& opcode = bytecode.get_opcode(m_scratch_state);
+    auto result = opcode.execute(input, m_scratch_state);
+    return result == ExecutionResult::Continue && m_scratch_state.string_position == position + 1;
+}
+
+LazyDFA::State* LazyDFA::step(State& state, ByteCode const& bytecode, MatchInput const& input, size_t position)
+{
+    // Compares only look at the code unit at `position`, except for surrogates, which may be read as part of a pair.
+    auto code_unit = input.view.code_unit_at(position);
+    auto is_cacheable = !is_unicode_surrogate(code_unit);
+    if (code_unit < state.ascii_transitions.size()) {
+        if (auto* next = state.ascii_transitions[code_unit])
+            return next;
+    } else if (is_cacheable) {
+        if (auto next = state.transitions.get(code_unit); next.has_value())
+            return *next;
+    }
+
+    Vector<u32> seeds;
+    seeds.extend(m_accept_nodes);
+    for (auto candidate : state.candidates) {
+        if (node_matches(m_nodes[candidate], bytecode, input, position))
+            seeds.append(candidate);
+    }
+
+    auto* next = state_for(move(seeds));
+    if (!next)
+        return nullptr;
+
+    if (code_unit < state.ascii_transitions.size()) {
+        state.ascii_transitions[code_unit] = next;
+    } else if (is_cacheable) {
+        state.transitions.set(code_unit, next);
+        m_memory_usage += sizeof(u32) + sizeof(State*);
+    }
+    return next;
+}
+
+bool LazyDFA::find_possible_match_starts(ByteCode const& bytecode, MatchInput const& input, size_t from, Bitmap& possible_starts)
+{
+    VERIFY(!input.view.unicode());
+
+    if (m_gave_up)
+        return false;
+
+    // Compares depend on the flags (e.g. case insensitivity), so transitions can't be shared between different ones.
+    if (m_options != input.regex_options.value()) {
+        clear_states();
+        m_options = input.regex_options.value();
+    }
+
+    auto give_up = [&] {
+        dbgln_if(REGEX_DEBUG, "LazyDFA: Exceeded the memory limit, falling back to the backtracker");
+        clear_states();
+        m_gave_up = true;
+        return false;
+    };
+
+    if (!m_initial_state) {
+        m_initial_state = state_for(Vector<u32> { m_accept_nodes });
+        if (!m_initial_state)
+            return give_up();
+    }
+
+    auto length = input.view.length();
+    VERIFY(from <= length);
+
+    auto* state = m_initial_state;
+    possible_starts.set(length, state->can_start_match);
+    for (auto position = length; position > from; --position) {
+        state = step(*state, bytecode, input, position - 1);
+        if (!state)
+            return give_up();
+        possible_starts.set(position - 1, state->can_start_match);
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexMatch.h"
+
+#include <AK/Array.h>
+#include <AK/Bitmap.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+static constexpr auto MaxLazyDFAMemoryUsage = 1 * MiB;
+
+// Scanning the input isn't worth it when there's only a little of it left to search.
+static constexpr size_t MinimumInputLengthForLazyDFA = 256;
+
+// A DFA over the reversed pattern, built one state at a time while scanning the input from its end.
+// After consuming the input from position i to the end, the current state knows whether a match can start at i,
+// which lets the backtracking matcher skip every start position that can't possibly succeed in linear time.
+//
+// Only the shape of the pattern is modelled: assertions, repetition counts and atomic groups are treated as if they
+// always allow every path, so the reported start positions are a superset of the real ones. Patterns with
+// backreferences or lookarounds aren't supported, and neither are unicode-mode inputs.
+class LazyDFA {
+public:
+    static OwnPtr<LazyDFA> try_create(ByteCode const&);
+
+    // Sets every position in [from, input.view.length()] at which a match may start in `possible_starts`.
+    // Returns false (and stops being usable) if the DFA would outgrow MaxLazyDFAMemoryUsage.
+    bool find_possible_match_starts(ByteCode const&, MatchInput const&, size_t from, Bitmap& possible_starts);
+
+    bool is_usable() const { return !m_gave_up; }
+
+private:
+    struct Node {
+        enum class Kind : u8 {
+            Epsilon,
+            Compare,
+            Literal,
+            Accept,
+        };
+
+        Kind kind { Kind::Epsilon };
+        u32 literal { 0 };
+        size_t instruction_position { 0 };
+        u32 next { 0 };
+    };
+
+    struct State {
+        Vector<u32> nodes;
+        Vector<u32> candidates;
+        bool can_start_match { false };
+        Array<State*, 128> ascii_transitions {};
+        HashMap<u32, State*> transitions;
+    };
+
+    struct NodeSetTraits : public DefaultTraits<Vector<u32>> {
+        static unsigned hash(Vector<u32> const& nodes)
+        {
+            unsigned hash = 0;
+            for (auto node : nodes)
+                hash = pair_int_hash(hash, node);
+            return hash;
+        }
+        static bool equals(Vector<u32> const& a, Vector<u32> const& b) { return a == b; }
+    };
+
+    LazyDFA() = default;
+
+    State* state_for(Vector<u32>&& seeds);
+    State* step(State&, ByteCode const&, MatchInput const&, size_t position);
+    bool node_matches(Node const&, ByteCode const&, MatchInput const&, size_t position);
+    void clear_states();
+
+    Vector<Node> m_nodes;
+    Vector<Vector<u32>> m_epsilon_predecessors;
+    Vector<Vector<u32>> m_consuming_predecessors;
+    Vector<u32> m_accept_nodes;
+    u32 m_start_node { 0 };
+
+    Vector<NonnullOwnPtr<State>> m_states;
+    HashMap<Vector<u32>, State*, NodeSetTraits> m_states_by_nodes;
+    State* m_initial_state { nullptr };
+    size_t m_memory_usage { 0 };
+    Optional<AllFlags> m_options;
+    bool m_gave_up { false };
+
+    Vector<u32> m_marks;
+    u32 m_generation { 0 };
+    MatchState m_scratch_state { 0 };
+};
+
+}
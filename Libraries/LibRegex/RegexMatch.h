@@ -50,6 +50,15 @@ public:
         return m_view.get<Utf16View>();
     }
 
+    // Calls the callback with the raw code units of the view: bytes for byte strings, UTF-16 code units otherwise.
+    template<typename Callback>
+    decltype(auto) visit_code_units(Callback&& callback) const
+    {
+        return m_view.visit(
+            [&](StringView view) { return callback(view.bytes()); },
+            [&](Utf16View const& view) { return callback(ReadonlySpan<u16> { view.data(), view.length_in_code_units() }); });
+    }
+
     bool unicode() const { return m_unicode; }
     void set_unicode(bool unicode) { m_unicode = unicode; }
 
@@ -11,6 +11,7 @@
 #include <AK/StringBuilder.h>
 #include <LibRegex/RegexMatcher.h>
 #include <LibRegex/RegexParser.h>
+#include <LibRegex/RegexPrefilter.h>
 
 #if REGEX_DEBUG
 #    include <LibRegex/RegexDebug.h>
@@ -42,24 +43,38 @@ struct CacheKey {
     }
 };
 template<class Parser>
-static OrderedHashMap<CacheKey<Parser>, regex::Parser::Result> s_parser_cache;
+static OrderedHashMap<CacheKey<Parser>, NonnullRefPtr<SharedParserResult>> s_parser_cache;
 
 template<class Parser>
 static size_t s_cached_bytecode_size = 0;
 
 static constexpr auto MaxRegexCachedBytecodeSize = 1 * MiB;
 
+// Optimized parse results are immutable once cached, and shared by every Regex that uses the same pattern and options.
+// The cache is shared by everything in the process (e.g. every realm), and evicts the least recently used patterns first.
 template<class Parser>
-static void cache_parse_result(regex::Parser::Result const& result, CacheKey<Parser> const& key)
+static RefPtr<SharedParserResult> cached_parse_result(CacheKey<Parser> const& key)
 {
-    auto bytecode_size = result.bytecode.size() * sizeof(ByteCodeValueType);
+    auto entry = s_parser_cache<Parser>.take(key);
+    if (!entry.has_value())
+        return nullptr;
+
+    // Re-inserting the entry moves it to the back of the eviction order.
+    s_parser_cache<Parser>.set(key, *entry);
+    return entry.release_value();
+}
+
+template<class Parser>
+static void cache_parse_result(NonnullRefPtr<SharedParserResult> result, CacheKey<Parser> const& key)
+{
+    auto bytecode_size = result->bytecode.size() * sizeof(ByteCodeValueType);
     if (bytecode_size > MaxRegexCachedBytecodeSize)
         return;
 
     while (bytecode_size + s_cached_bytecode_size<Parser> > MaxRegexCachedBytecodeSize)
-        s_cached_bytecode_size<Parser> -= s_parser_cache<Parser>.take_first().bytecode.size() * sizeof(ByteCodeValueType);
+        s_cached_bytecode_size<Parser> -= s_parser_cache<Parser>.take_first()->bytecode.size() * sizeof(ByteCodeValueType);
 
-    s_parser_cache<Parser>.set(key, result);
+    s_parser_cache<Parser>.set(key, move(result));
     s_cached_bytecode_size<Parser> += bytecode_size;
 }
 
@@ -67,32 +82,41 @@ template<class Parser>
 Regex<Parser>::Regex(ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options)
     : pattern_value(move(pattern))
 {
-    if (auto cache_entry = s_parser_cache<Parser>.get({ pattern_value, regex_options }); cache_entry.has_value()) {
-        parser_result = cache_entry.value();
+    if (auto cache_entry = cached_parse_result<Parser>({ pattern_value, regex_options })) {
+        parser_result = move(cache_entry);
     } else {
         regex::Lexer lexer(pattern_value);
 
         Parser parser(lexer, regex_options);
-        parser_result = parser.parse();
+        parser_result = adopt_ref(*new SharedParserResult(parser.parse()));
 
         run_optimization_passes();
 
-        if (parser_result.error == regex::Error::NoError)
-            cache_parse_result<Parser>(parser_result, { pattern_value, regex_options });
+        if (parser_result->error == regex::Error::NoError)
+            cache_parse_result<Parser>(*parser_result, { pattern_value, regex_options });
     }
 
-    if (parser_result.error == regex::Error::NoError)
-        matcher = make<Matcher<Parser>>(this, static_cast<decltype(regex_options.value())>(parser_result.options.value()));
+    if (parser_result->error == regex::Error::NoError)
+        matcher = make<Matcher<Parser>>(this, static_cast<decltype(regex_options.value())>(parser_result->options.value()));
 }
 
 template<class Parser>
-Regex<Parser>::Regex(regex::Parser::Result parse_result, ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options)
+Regex<Parser>::Regex(regex::Parser::Result const& parse_result, ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options)
     : pattern_value(move(pattern))
-    , parser_result(move(parse_result))
 {
-    run_optimization_passes();
-    if (parser_result.error == regex::Error::NoError)
-        matcher = make<Matcher<Parser>>(this, regex_options | static_cast<decltype(regex_options.value())>(parser_result.options.value()));
+    // The parse result was produced from this same pattern and options, so it can share the optimized result with every other Regex for it.
+    if (auto cache_entry = cached_parse_result<Parser>({ pattern_value, regex_options })) {
+        parser_result = move(cache_entry);
+    } else {
+        parser_result = adopt_ref(*new SharedParserResult(parse_result));
+        run_optimization_passes();
+
+        if (parser_result->error == regex::Error::NoError)
+            cache_parse_result<Parser>(*parser_result, { pattern_value, regex_options });
+    }
+
+    if (parser_result->error == regex::Error::NoError)
+        matcher = make<Matcher<Parser>>(this, regex_options | static_cast<decltype(regex_options.value())>(parser_result->options.value()));
 }
 
 template<class Parser>
@@ -121,7 +145,7 @@ Regex<Parser>& Regex<Parser>::operator=(Regex&& regex)
 template<class Parser>
 typename ParserTraits<Parser>::OptionsType Regex<Parser>::options() const
 {
-    if (!matcher || parser_result.error != Error::NoError)
+    if (!matcher || parser_result->error != Error::NoError)
         return {};
 
     return matcher->options();
@@ -133,10 +157,10 @@ ByteString Regex<Parser>::error_string(Optional<ByteString> message) const
     StringBuilder eb;
     eb.append("Error during parsing of regular expression:\n"sv);
     eb.appendff("    {}\n    ", pattern_value);
-    for (size_t i = 0; i < parser_result.error_token.position(); ++i)
+    for (size_t i = 0; i < parser_result->error_token.position(); ++i)
         eb.append(' ');
 
-    eb.appendff("^---- {}", message.value_or(get_error_string(parser_result.error)));
+    eb.appendff("^---- {}", message.value_or(get_error_string(parser_result->error)));
     return eb.to_byte_string();
 }
 
@@ -162,10 +186,14 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     if (!((AllFlags)m_regex_options.value() & AllFlags::Internal_Stateful))
         m_pattern->start_offset = 0;
 
+    // Anything learned about a previous input must not outlive the caller's promise that it's still the same.
+    if (!exchange(m_pattern->input_unchanged_since_last_match, false) || views.size() != 1)
+        m_possible_match_starts.clear();
+
     size_t match_count { 0 };
 
     MatchInput input;
-    MatchState state { m_pattern->parser_result.capture_groups_count };
+    MatchState state { m_pattern->parser_result->capture_groups_count };
     size_t operations = 0;
 
     input.regex_options = m_regex_options | regex_options.value_or({}).value();
@@ -207,7 +235,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         continue_search = false;
 
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
-    auto only_start_of_line = m_pattern->parser_result.optimization_data.only_start_of_line && !input.regex_options.has_flag_set(AllFlags::Multiline);
+    auto only_start_of_line = m_pattern->parser_result->optimization_data.only_start_of_line && !input.regex_options.has_flag_set(AllFlags::Multiline);
 
     auto compare_range = [insensitive = input.regex_options & AllFlags::Insensitive](auto needle, CharRange range) {
         auto upper_case_needle = needle;
@@ -226,6 +254,8 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         return -1;
     };
 
+    auto const& optimization_data = m_pattern->parser_result->optimization_data;
+
     for (auto const& view : views) {
         if (lines_to_skip != 0) {
             ++input.line;
@@ -241,7 +271,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         state.string_position_in_code_units = view_index;
         bool succeeded = false;
 
-        if (view_index == view_length && m_pattern->parser_result.match_length_minimum == 0) {
+        if (view_index == view_length && m_pattern->parser_result->match_length_minimum == 0) {
             // Run the code until it tries to consume something.
             // This allows non-consuming code to run on empty strings, for instance
             // e.g. "Exit"
@@ -270,6 +300,16 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             }
         }
 
+        Bitmap const* possible_starts = cached_possible_match_starts(input, view_index);
+
+        // The prefilters compare raw code units, which only line up with string positions outside of unicode mode.
+        auto const can_scan_code_units = !view.unicode() && !(input.regex_options & AllFlags::Insensitive);
+        auto const can_skip_ahead = can_scan_code_units && continue_search && !only_start_of_line;
+        auto const* starting_literal = can_scan_code_units && optimization_data.starting_literal.has_value() ? &*optimization_data.starting_literal : nullptr;
+        auto const* required_literal = can_scan_code_units && optimization_data.required_literal.has_value() ? &*optimization_data.required_literal : nullptr;
+        auto const scan_starting_ranges = can_skip_ahead && !starting_literal && optimization_data.starting_ranges.size() <= MaxRangesForVectorizedScan;
+        Optional<size_t> required_literal_position;
+
         for (; view_index <= view_length; ++view_index) {
             if (view_index == view_length) {
                 if (input.regex_options.has_flag_set(AllFlags::Multiline))
@@ -282,15 +322,40 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             //        the remaining string length from the current path. The value though
             //        has to be filled in reverse. That implies a second run over bytecode
             //        after generation has finished.
-            auto const match_length_minimum = m_pattern->parser_result.match_length_minimum;
+            auto const match_length_minimum = m_pattern->parser_result->match_length_minimum;
             if (match_length_minimum && match_length_minimum > view_length - view_index)
                 break;
 
-            if (auto& starting_ranges = m_pattern->parser_result.optimization_data.starting_ranges; !starting_ranges.is_empty()) {
-                if (!binary_search(starting_ranges, input.view.code_unit_at(view_index), nullptr, compare_range))
+            if (starting_literal) {
+                auto position = find_literal(input.view, *starting_literal, view_index);
+                if (!position.has_value())
+                    break;
+                if (*position != view_index) {
+                    if (!can_skip_ahead)
+                        goto done_matching;
+                    view_index = *position;
+                }
+            } else if (auto& starting_ranges = optimization_data.starting_ranges; !starting_ranges.is_empty()) {
+                if (scan_starting_ranges) {
+                    auto position = find_code_unit_in_ranges(input.view, starting_ranges, view_index);
+                    if (!position.has_value())
+                        break;
+                    view_index = *position;
+                } else if (!binary_search(starting_ranges, input.view.code_unit_at(view_index), nullptr, compare_range)) {
                     goto done_matching;
+                }
             }
 
+            // Any match starting here has to contain the required literal, so stop once it no longer occurs.
+            if (required_literal && (!required_literal_position.has_value() || *required_literal_position < view_index)) {
+                required_literal_position = find_literal(input.view, *required_literal, view_index);
+                if (!required_literal_position.has_value())
+                    break;
+            }
+
+            if (possible_starts && !possible_starts->get(view_index))
+                goto done_matching;
+
             input.column = match_count;
             input.match_index = match_count;
 
@@ -339,6 +404,10 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
                 break;
             }
 
+            // Rather than retrying the backtracker at every following position, find out where a match can start at all.
+            if (!possible_starts && continue_search && !only_start_of_line)
+                possible_starts = find_possible_match_starts(input, view_index + 1);
+
         done_matching:
             if (!continue_search || only_start_of_line)
                 break;
@@ -374,8 +443,8 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         move(flat_capture_group_matches),
         move(capture_group_matches),
         operations,
-        m_pattern->parser_result.capture_groups_count,
-        m_pattern->parser_result.named_capture_groups_count,
+        m_pattern->parser_result->capture_groups_count,
+        m_pattern->parser_result->named_capture_groups_count,
     };
 
     if (match_count > 0)
@@ -386,6 +455,52 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     return result;
 }
 
+template<class Parser>
+Bitmap const* Matcher<Parser>::find_possible_match_starts(MatchInput const& input, size_t from) const
+{
+    if (input.view.unicode() || from > input.view.length() || input.view.length() - from < MinimumInputLengthForLazyDFA)
+        return nullptr;
+
+    if (!m_lazy_dfa_initialized) {
+        m_lazy_dfa = LazyDFA::try_create(m_pattern->parser_result->bytecode);
+        m_lazy_dfa_initialized = true;
+    }
+    if (!m_lazy_dfa || !m_lazy_dfa->is_usable())
+        return nullptr;
+
+    m_possible_match_starts.clear();
+    auto possible_starts = Bitmap::create(input.view.length() + 1, false);
+    if (possible_starts.is_error())
+        return nullptr;
+    if (!m_lazy_dfa->find_possible_match_starts(m_pattern->parser_result->bytecode, input, from, possible_starts.value()))
+        return nullptr;
+
+    m_possible_match_starts = PossibleMatchStarts {
+        .bitmap = possible_starts.release_value(),
+        .from = from,
+        .input_data = input.view.visit_code_units([](auto code_units) -> void const* { return code_units.data(); }),
+        .input_length = input.view.length(),
+        .options = input.regex_options.value(),
+    };
+    return &m_possible_match_starts->bitmap;
+}
+
+// The scan for possible match starts covers everything from where it began to the end of the input, so when searching
+// the same input again from a later position (as a global RegExp's exec() does), there's no need to scan it again.
+template<class Parser>
+Bitmap const* Matcher<Parser>::cached_possible_match_starts(MatchInput const& input, size_t from) const
+{
+    if (!m_possible_match_starts.has_value())
+        return nullptr;
+
+    auto& cached = *m_possible_match_starts;
+    if (from < cached.from || cached.input_length != input.view.length() || cached.options != input.regex_options.value())
+        return nullptr;
+    if (cached.input_data != input.view.visit_code_units([](auto code_units) -> void const* { return code_units.data(); }))
+        return nullptr;
+    return &cached.bitmap;
+}
+
 template<typename T>
 class BumpAllocatedLinkedList {
 public:
@@ -483,7 +598,7 @@ bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t
     size_t recursion_level = 0;
 #endif
 
-    auto& bytecode = m_pattern->parser_result.bytecode;
+    auto& bytecode = m_pattern->parser_result->bytecode;
 
     for (;;) {
         auto& opcode = bytecode.get_opcode(state);
@@ -7,12 +7,15 @@
 #pragma once
 
 #include "RegexByteCode.h"
+#include "RegexLazyDFA.h"
 #include "RegexMatch.h"
 #include "RegexOptions.h"
 #include "RegexParser.h"
 
 #include <AK/Forward.h>
 #include <AK/GenericLexer.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <ctype.h>
 
@@ -32,6 +35,15 @@ struct Block {
 
 static constexpr size_t const c_max_recursion = 5000;
 
+// An optimized parse result, shared (without copying its bytecode) by every Regex for the same pattern and options.
+struct SharedParserResult final : public RefCounted<SharedParserResult>
+    , public regex::Parser::Result {
+    explicit SharedParserResult(regex::Parser::Result result)
+        : regex::Parser::Result(move(result))
+    {
+    }
+};
+
 struct RegexResult final {
     bool success { false };
     size_t count { 0 };
@@ -72,23 +84,45 @@ public:
 
 private:
     bool execute(MatchInput const& input, MatchState& state, size_t& operations) const;
+    Bitmap const* find_possible_match_starts(MatchInput const& input, size_t from) const;
+    Bitmap const* cached_possible_match_starts(MatchInput const& input, size_t from) const;
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
+
+    mutable OwnPtr<LazyDFA> m_lazy_dfa;
+    mutable bool m_lazy_dfa_initialized { false };
+
+    // The most recently found possible match starts, which later matches on the very same input can reuse.
+    struct PossibleMatchStarts {
+        Bitmap bitmap;
+        size_t from { 0 };
+        void const* input_data { nullptr };
+        size_t input_length { 0 };
+        AllFlags options {};
+    };
+    mutable Optional<PossibleMatchStarts> m_possible_match_starts;
 };
 
 template<class Parser>
 class Regex final {
 public:
     ByteString pattern_value;
-    regex::Parser::Result parser_result;
+    // NOTE: This may be shared with other Regexes through the parse result cache, so it must not be modified once the
+    //       Regex has been constructed. It's only null in a Regex that has been moved from.
+    RefPtr<SharedParserResult> parser_result;
     OwnPtr<Matcher<Parser>> matcher { nullptr };
     mutable size_t start_offset { 0 };
 
+    // Callers that run stateful matches over the same input again and again (e.g. a global RegExp's exec()) may set
+    // this to promise that the input is the same one, with the same contents, as in the previous match. This lets the
+    // matcher reuse what it learned about the input. Only applies to the next match.
+    mutable bool input_unchanged_since_last_match { false };
+
     static regex::Parser::Result parse_pattern(StringView pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
 
     explicit Regex(ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
-    Regex(regex::Parser::Result parse_result, ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
+    Regex(regex::Parser::Result const& parse_result, ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
     ~Regex() = default;
     Regex(Regex&&);
     Regex& operator=(Regex&&);
@@ -98,21 +132,21 @@ public:
 
     RegexResult match(RegexStringView view, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {}) const
     {
-        if (!matcher || parser_result.error != Error::NoError)
+        if (!matcher || parser_result->error != Error::NoError)
             return {};
         return matcher->match(view, regex_options);
     }
 
     RegexResult match(Vector<RegexStringView> const& views, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {}) const
     {
-        if (!matcher || parser_result.error != Error::NoError)
+        if (!matcher || parser_result->error != Error::NoError)
             return {};
         return matcher->match(views, regex_options);
     }
 
     ByteString replace(RegexStringView view, StringView replacement_pattern, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {}) const
     {
-        if (!matcher || parser_result.error != Error::NoError)
+        if (!matcher || parser_result->error != Error::NoError)
             return {};
 
         StringBuilder builder;
@@ -153,7 +187,7 @@ public:
 
     RegexResult search(RegexStringView view, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {}) const
     {
-        if (!matcher || parser_result.error != Error::NoError)
+        if (!matcher || parser_result->error != Error::NoError)
             return {};
 
         AllOptions options = (AllOptions)regex_options.value_or({});
@@ -169,7 +203,7 @@ public:
 
     RegexResult search(Vector<RegexStringView> const& views, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {}) const
     {
-        if (!matcher || parser_result.error != Error::NoError)
+        if (!matcher || parser_result->error != Error::NoError)
             return {};
 
         AllOptions options = (AllOptions)regex_options.value_or({});
@@ -209,7 +243,7 @@ public:
 
     bool has_match(RegexStringView view, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {}) const
     {
-        if (!matcher || parser_result.error != Error::NoError)
+        if (!matcher || parser_result->error != Error::NoError)
             return false;
         RegexResult result = matcher->match(view, AllOptions { regex_options.value_or({}) } | AllFlags::SkipSubExprResults);
         return result.success;
@@ -217,7 +251,7 @@ public:
 
     bool has_match(Vector<RegexStringView> const& views, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {}) const
     {
-        if (!matcher || parser_result.error != Error::NoError)
+        if (!matcher || parser_result->error != Error::NoError)
             return false;
         RegexResult result = matcher->match(views, AllOptions { regex_options.value_or({}) } | AllFlags::SkipSubExprResults);
         return result.success;
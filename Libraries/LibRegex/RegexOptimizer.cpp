@@ -6,9 +6,11 @@
 
 #include <AK/Debug.h>
 #include <AK/Function.h>
+#include <AK/HashMap.h>
 #include <AK/QuickSort.h>
 #include <AK/RedBlackTree.h>
 #include <AK/Stack.h>
+#include <AK/StringBuilder.h>
 #include <AK/Trie.h>
 #include <AK/Vector.h>
 #include <LibRegex/Regex.h>
@@ -26,21 +28,23 @@ using Detail::Block;
 template<typename Parser>
 void Regex<Parser>::run_optimization_passes()
 {
-    parser_result.bytecode.flatten();
+    parser_result->bytecode.flatten();
 
     rewrite_with_useless_jumps_removed();
 
-    auto blocks = split_basic_blocks(parser_result.bytecode);
-    if (attempt_rewrite_entire_match_as_substring_search(blocks))
+    auto blocks = split_basic_blocks(parser_result->bytecode);
+    if (attempt_rewrite_entire_match_as_substring_search(blocks)) {
+        fill_optimization_data(blocks);
         return;
+    }
 
     // Rewrite fork loops as atomic groups
     // e.g. a*b -> (ATOMIC a*)b
     attempt_rewrite_loops_as_atomic_groups(blocks);
 
-    fill_optimization_data(split_basic_blocks(parser_result.bytecode));
+    fill_optimization_data(split_basic_blocks(parser_result->bytecode));
 
-    parser_result.bytecode.flatten();
+    parser_result->bytecode.flatten();
 }
 
 struct StaticallyInterpretedCompares {
@@ -178,6 +182,271 @@ static bool interpret_compares(Vector<CompareTypeAndValuePair> const& lhs, Stati
     return true;
 }
 
+// Inserts ranges covering every code point that a (non-negated) character class can match.
+// These are only used to skip positions that can't start a match, so covering a few more code points is fine.
+static void insert_character_class_ranges(CharClass character_class, bool unicode_insensitive, RedBlackTree<u32, u32>& ranges)
+{
+    switch (character_class) {
+    case CharClass::Alnum:
+        ranges.insert('0', '9');
+        ranges.insert('A', 'Z');
+        ranges.insert('a', 'z');
+        return;
+    case CharClass::Alpha:
+        ranges.insert('A', 'Z');
+        ranges.insert('a', 'z');
+        return;
+    case CharClass::Blank:
+        ranges.insert('\t', '\t');
+        ranges.insert(' ', ' ');
+        return;
+    case CharClass::Cntrl:
+        ranges.insert(0x00, 0x1f);
+        ranges.insert(0x7f, 0x7f);
+        return;
+    case CharClass::Digit:
+        ranges.insert('0', '9');
+        return;
+    case CharClass::Graph:
+    case CharClass::Punct:
+        ranges.insert(0x21, 0x7e);
+        return;
+    case CharClass::Print:
+        ranges.insert(0x20, 0x7e);
+        return;
+    case CharClass::Space:
+        // Every other space separator and line terminator lies above U+00A0.
+        ranges.insert('\t', '\r');
+        ranges.insert(' ', ' ');
+        ranges.insert(0xa0, 0x10ffff);
+        return;
+    case CharClass::Lower:
+    case CharClass::Upper:
+        // Case-insensitive matching is handled by the comparison against these ranges.
+        ranges.insert('A', 'Z');
+        ranges.insert('a', 'z');
+        return;
+    case CharClass::Word:
+        ranges.insert('0', '9');
+        ranges.insert('A', 'Z');
+        ranges.insert('_', '_');
+        ranges.insert('a', 'z');
+        if (unicode_insensitive) {
+            // U+017F LATIN SMALL LETTER LONG S and U+212A KELVIN SIGN case-fold to 's' and 'k'.
+            ranges.insert(0x017f, 0x017f);
+            ranges.insert(0x212a, 0x212a);
+        }
+        return;
+    case CharClass::Xdigit:
+        ranges.insert('0', '9');
+        ranges.insert('A', 'F');
+        ranges.insert('a', 'f');
+        return;
+    }
+
+    VERIFY_NOT_REACHED();
+}
+
+// Appends the literal matched by a Compare to `literal`, if that Compare only matches a single run of ASCII characters.
+static bool append_compare_literal(ByteCode const& bytecode, size_t instruction_position, StringBuilder& literal)
+{
+    if (bytecode.at(instruction_position + 1) != 1)
+        return false;
+
+    auto offset = instruction_position + 3;
+    size_t length = 1;
+    switch (static_cast<CharacterCompareType>(bytecode.at(offset++))) {
+    case CharacterCompareType::Char:
+        break;
+    case CharacterCompareType::String:
+        length = bytecode.at(offset++);
+        break;
+    default:
+        return false;
+    }
+
+    if (length == 0)
+        return false;
+    for (size_t i = 0; i < length; ++i) {
+        if (bytecode.at(offset + i) >= 0x80)
+            return false;
+    }
+    for (size_t i = 0; i < length; ++i)
+        literal.append(static_cast<char>(bytecode.at(offset + i)));
+    return true;
+}
+
+// Returns the literal made up of the compares that every match executes first.
+static Optional<ByteString> find_starting_literal(ByteCode const& bytecode)
+{
+    StringBuilder literal;
+    auto state = MatchState::only_for_enumeration();
+    for (state.instruction_position = 0; state.instruction_position < bytecode.size();) {
+        auto& opcode = bytecode.get_opcode(state);
+        bool keep_going = true;
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            keep_going = append_compare_literal(bytecode, state.instruction_position, literal);
+            break;
+        case OpCodeId::Checkpoint:
+        case OpCodeId::Save:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+            // These do not 'match' anything, so look through them.
+            break;
+        default:
+            keep_going = false;
+            break;
+        }
+        if (!keep_going)
+            break;
+        state.instruction_position += opcode.size();
+    }
+
+    if (literal.is_empty())
+        return {};
+    return literal.to_byte_string();
+}
+
+// Finding required literals is quadratic in the number of instructions, so give up on patterns larger than this.
+static constexpr size_t MaxInstructionsForRequiredLiteralSearch = 1024;
+
+// Returns the longest literal that every path from the start of the bytecode to a successful exit has to match.
+static Optional<ByteString> find_required_literal(ByteCode const& bytecode)
+{
+    Vector<size_t> instruction_positions;
+    HashMap<size_t, size_t> instruction_index;
+
+    auto state = MatchState::only_for_enumeration();
+    for (state.instruction_position = 0; state.instruction_position < bytecode.size();) {
+        auto& opcode = bytecode.get_opcode(state);
+        // Lookbehinds match input before the current position, which could be before the start of the match.
+        if (opcode.opcode_id() == OpCodeId::GoBack)
+            return {};
+        if (instruction_positions.size() == MaxInstructionsForRequiredLiteralSearch)
+            return {};
+        instruction_index.set(state.instruction_position, instruction_positions.size());
+        instruction_positions.append(state.instruction_position);
+        state.instruction_position += opcode.size();
+    }
+
+    // Running off the end of the bytecode is the same as reaching an Exit.
+    auto const end_index = instruction_positions.size();
+    Vector<Vector<size_t>> successors;
+    successors.resize(end_index);
+    Vector<size_t> predecessor_counts;
+    predecessor_counts.resize(end_index + 1);
+
+    // Every instruction that may continue in more than one way is assumed to take every path it could take.
+    for (size_t i = 0; i < end_index; ++i) {
+        state.instruction_position = instruction_positions[i];
+        auto& opcode = bytecode.get_opcode(state);
+        auto next_instruction_position = static_cast<ssize_t>(state.instruction_position + opcode.size());
+
+        auto add_successor = [&](ssize_t target) {
+            if (target < 0)
+                return false;
+            size_t index = end_index;
+            if (static_cast<size_t>(target) < bytecode.size()) {
+                auto target_index = instruction_index.get(target);
+                if (!target_index.has_value())
+                    return false;
+                index = *target_index;
+            }
+            successors[i].append(index);
+            ++predecessor_counts[index];
+            return true;
+        };
+
+        bool ok = true;
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Exit:
+            ok = add_successor(bytecode.size());
+            break;
+        case OpCodeId::Jump:
+            ok = add_successor(next_instruction_position + static_cast<OpCode_Jump const&>(opcode).offset());
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            ok = add_successor(next_instruction_position)
+                && add_successor(next_instruction_position + static_cast<OpCode_ForkJump const&>(opcode).offset());
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            ok = add_successor(next_instruction_position)
+                && add_successor(next_instruction_position + static_cast<OpCode_ForkStay const&>(opcode).offset());
+            break;
+        case OpCodeId::JumpNonEmpty:
+            ok = add_successor(next_instruction_position)
+                && add_successor(next_instruction_position + static_cast<OpCode_JumpNonEmpty const&>(opcode).offset());
+            break;
+        case OpCodeId::Repeat:
+            ok = add_successor(next_instruction_position)
+                && add_successor(static_cast<ssize_t>(state.instruction_position - static_cast<OpCode_Repeat const&>(opcode).offset()));
+            break;
+        default:
+            ok = add_successor(next_instruction_position);
+            break;
+        }
+        if (!ok)
+            return {};
+    }
+
+    // Consecutive literal compares form one literal, as long as nothing can jump between them.
+    struct LiteralRun {
+        size_t first_instruction;
+        size_t last_instruction;
+        StringBuilder literal;
+    };
+    Vector<LiteralRun> runs;
+    for (size_t i = 0; i < end_index; ++i) {
+        state.instruction_position = instruction_positions[i];
+        if (bytecode.get_opcode(state).opcode_id() != OpCodeId::Compare)
+            continue;
+        StringBuilder literal;
+        if (!append_compare_literal(bytecode, instruction_positions[i], literal))
+            continue;
+        if (!runs.is_empty() && runs.last().last_instruction + 1 == i && predecessor_counts[i] == 1) {
+            runs.last().last_instruction = i;
+            runs.last().literal.append(literal.string_view());
+            continue;
+        }
+        runs.append({ i, i, move(literal) });
+    }
+
+    quick_sort(runs, [](auto const& a, auto const& b) { return a.literal.length() > b.literal.length(); });
+
+    // A run is required if the exit can't be reached without going through its first instruction.
+    Vector<bool> visited;
+    Vector<size_t> worklist;
+    for (auto const& run : runs) {
+        visited.clear();
+        visited.resize(end_index + 1);
+        worklist.clear();
+        if (run.first_instruction != 0) {
+            visited[0] = true;
+            worklist.append(0);
+        }
+        visited[run.first_instruction] = true;
+        while (!worklist.is_empty() && !visited[end_index]) {
+            auto index = worklist.take_last();
+            for (auto successor : successors[index]) {
+                if (visited[successor])
+                    continue;
+                visited[successor] = true;
+                if (successor != end_index)
+                    worklist.append(successor);
+            }
+        }
+        if (!visited[end_index])
+            return run.literal.to_byte_string();
+    }
+
+    return {};
+}
+
 template<class Parser>
 void Regex<Parser>::fill_optimization_data(BasicBlockList const& blocks)
 {
@@ -195,15 +464,23 @@ void Regex<Parser>::fill_optimization_data(BasicBlockList const& blocks)
     ScopeGuard print = [&] {
         if constexpr (REGEX_DEBUG) {
             dbgln("Optimization data:");
-            if (parser_result.optimization_data.starting_ranges.is_empty())
+            if (parser_result->optimization_data.starting_ranges.is_empty())
                 dbgln("; - no starting ranges");
-            for (auto const& range : parser_result.optimization_data.starting_ranges)
+            for (auto const& range : parser_result->optimization_data.starting_ranges)
                 dbgln("  - starting range: {}-{}", range.from, range.to);
-            dbgln("; - only start of line: {}", parser_result.optimization_data.only_start_of_line);
+            dbgln("; - only start of line: {}", parser_result->optimization_data.only_start_of_line);
+            if (parser_result->optimization_data.starting_literal.has_value())
+                dbgln("; - starting literal: '{}'", *parser_result->optimization_data.starting_literal);
+            if (parser_result->optimization_data.required_literal.has_value())
+                dbgln("; - required literal: '{}'", *parser_result->optimization_data.required_literal);
         }
     };
 
-    auto& bytecode = parser_result.bytecode;
+    auto& bytecode = parser_result->bytecode;
+
+    parser_result->optimization_data.starting_literal = find_starting_literal(bytecode);
+    if (!parser_result->optimization_data.starting_literal.has_value())
+        parser_result->optimization_data.required_literal = find_required_literal(bytecode);
 
     auto state = MatchState::only_for_enumeration();
     auto block = blocks.first();
@@ -220,15 +497,29 @@ void Regex<Parser>::fill_optimization_data(BasicBlockList const& blocks)
                 return; // Faster to just run the bytecode.
 
             // FIXME: We should be able to handle these cases (jump ahead while...)
-            if (!compares.lhs_char_classes.is_empty() || !compares.lhs_negated_char_classes.is_empty() || !compares.lhs_negated_ranges.is_empty())
+            if (!compares.lhs_negated_char_classes.is_empty() || !compares.lhs_negated_ranges.is_empty())
                 return;
 
-            for (auto it = compares.lhs_ranges.begin(); it != compares.lhs_ranges.end(); ++it)
-                parser_result.optimization_data.starting_ranges.append({ it.key(), *it });
+            auto const& options = parser_result->options;
+            auto const unicode_insensitive = options.has_flag_set(AllFlags::Insensitive)
+                && (options.has_flag_set(AllFlags::Unicode) || options.has_flag_set(AllFlags::UnicodeSets));
+            for (auto character_class : compares.lhs_char_classes)
+                insert_character_class_ranges(character_class, unicode_insensitive, compares.lhs_ranges);
+
+            // The matcher binary-searches these, so overlapping or adjacent ranges have to be merged.
+            auto& starting_ranges = parser_result->optimization_data.starting_ranges;
+            for (auto it = compares.lhs_ranges.begin(); it != compares.lhs_ranges.end(); ++it) {
+                if (!starting_ranges.is_empty() && starting_ranges.last().to + 1 >= it.key()) {
+                    auto last = starting_ranges.take_last();
+                    starting_ranges.append({ last.from, max(last.to, *it) });
+                    continue;
+                }
+                starting_ranges.append({ it.key(), *it });
+            }
             return;
         }
         case OpCodeId::CheckBegin:
-            parser_result.optimization_data.only_start_of_line = true;
+            parser_result->optimization_data.only_start_of_line = true;
             return;
         case OpCodeId::Checkpoint:
         case OpCodeId::Save:
@@ -403,7 +694,7 @@ static bool has_overlap(Vector<CompareTypeAndValuePair> const& lhs, Vector<Compa
             auto start = it.key();
             auto end = *it;
             for (u32 ch = start; ch <= end; ++ch) {
-                if (OpCode_Compare::matches_character_class(value, ch, false))
+                if (OpCode_Compare::matches_character_class(value, ch, false, false))
                     return true;
             }
         }
@@ -777,13 +1068,13 @@ bool Regex<Parser>::attempt_rewrite_entire_match_as_substring_search(BasicBlockL
         return false;
 
     if (basic_blocks.is_empty()) {
-        parser_result.optimization_data.pure_substring_search = ""sv;
+        parser_result->optimization_data.pure_substring_search = ""sv;
         return true; // Empty regex, sure.
     }
 
-    auto& bytecode = parser_result.bytecode;
+    auto& bytecode = parser_result->bytecode;
 
-    auto is_unicode = parser_result.options.has_flag_set(AllFlags::Unicode) || parser_result.options.has_flag_set(AllFlags::UnicodeSets);
+    auto is_unicode = parser_result->options.has_flag_set(AllFlags::Unicode) || parser_result->options.has_flag_set(AllFlags::UnicodeSets);
 
     // We have a single basic block, let's see if it's a series of character or string compares.
     StringBuilder final_string;
@@ -810,14 +1101,14 @@ bool Regex<Parser>::attempt_rewrite_entire_match_as_substring_search(BasicBlockL
         state.instruction_position += opcode.size();
     }
 
-    parser_result.optimization_data.pure_substring_search = final_string.to_byte_string();
+    parser_result->optimization_data.pure_substring_search = final_string.to_byte_string();
     return true;
 }
 
 template<class Parser>
 void Regex<Parser>::rewrite_with_useless_jumps_removed()
 {
-    auto& bytecode = parser_result.bytecode;
+    auto& bytecode = parser_result->bytecode;
     auto flat = bytecode.flat_data();
 
     if constexpr (REGEX_DEBUG) {
@@ -928,13 +1219,13 @@ void Regex<Parser>::rewrite_with_useless_jumps_removed()
     }
 
     out.flatten();
-    parser_result.bytecode = move(out);
+    parser_result->bytecode = move(out);
 }
 
 template<typename Parser>
 void Regex<Parser>::attempt_rewrite_loops_as_atomic_groups(BasicBlockList const& basic_blocks)
 {
-    auto& bytecode = parser_result.bytecode;
+    auto& bytecode = parser_result->bytecode;
     if constexpr (REGEX_DEBUG) {
         RegexDebug dbg;
         dbg.print_bytecode(*this);
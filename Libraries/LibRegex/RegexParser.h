@@ -66,6 +66,10 @@ public:
             Optional<ByteString> pure_substring_search;
             // If populated, the pattern only accepts strings that start with a character in these ranges.
             Vector<CharRange> starting_ranges;
+            // If populated, the pattern only accepts strings that start with this (ASCII, case-sensitive) literal.
+            Optional<ByteString> starting_literal;
+            // If populated, every match contains this (ASCII, case-sensitive) literal at or after its start.
+            Optional<ByteString> required_literal;
             bool only_start_of_line = false;
         } optimization_data {};
     };
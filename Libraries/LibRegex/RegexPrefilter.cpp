@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/BitCast.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/NumericLimits.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <LibRegex/RegexPrefilter.h>
+
+namespace regex {
+
+template<typename CodeUnit>
+using VectorFor = Conditional<IsSame<CodeUnit, u8>, AK::SIMD::u8x16, AK::SIMD::u16x8>;
+
+template<typename CodeUnit, typename MaskType>
+ALWAYS_INLINE static Optional<size_t> first_set_lane(MaskType mask)
+{
+    static_assert(sizeof(MaskType) == sizeof(AK::SIMD::u64x2));
+    auto halves = bit_cast<AK::SIMD::u64x2>(mask);
+    if (halves[0] != 0)
+        return count_trailing_zeroes(halves[0]) / 8 / sizeof(CodeUnit);
+    if (halves[1] != 0)
+        return (8 + count_trailing_zeroes(halves[1]) / 8) / sizeof(CodeUnit);
+    return {};
+}
+
+template<typename CodeUnit>
+static Optional<size_t> find_code_unit(ReadonlySpan<CodeUnit> haystack, CodeUnit needle, size_t from)
+{
+    using VectorType = VectorFor<CodeUnit>;
+    constexpr size_t lane_count = sizeof(VectorType) / sizeof(CodeUnit);
+
+    auto const needles = VectorType {} + needle;
+
+    size_t position = from;
+    for (; position + lane_count <= haystack.size(); position += lane_count) {
+        auto chunk = AK::SIMD::load_unaligned<VectorType>(haystack.data() + position);
+        if (auto lane = first_set_lane<CodeUnit>(chunk == needles); lane.has_value())
+            return position + *lane;
+    }
+
+    for (; position < haystack.size(); ++position) {
+        if (haystack[position] == needle)
+            return position;
+    }
+    return {};
+}
+
+template<typename CodeUnit>
+static Optional<size_t> find_literal(ReadonlySpan<CodeUnit> haystack, StringView literal, size_t from)
+{
+    VERIFY(!literal.is_empty());
+    if (literal.length() > haystack.size())
+        return {};
+
+    // Only positions with room for the whole literal are candidates.
+    auto candidates = haystack.trim(haystack.size() - literal.length() + 1);
+    auto first_code_unit = static_cast<CodeUnit>(literal[0]);
+
+    while (from < candidates.size()) {
+        auto position = find_code_unit(candidates, first_code_unit, from);
+        if (!position.has_value())
+            return {};
+
+        bool matches = true;
+        for (size_t i = 1; i < literal.length(); ++i) {
+            if (haystack[*position + i] != static_cast<CodeUnit>(literal[i])) {
+                matches = false;
+                break;
+            }
+        }
+        if (matches)
+            return position;
+
+        from = *position + 1;
+    }
+    return {};
+}
+
+template<typename CodeUnit>
+static Optional<size_t> find_code_unit_in_ranges(ReadonlySpan<CodeUnit> haystack, ReadonlySpan<CharRange> ranges, size_t from)
+{
+    using VectorType = VectorFor<CodeUnit>;
+    constexpr size_t lane_count = sizeof(VectorType) / sizeof(CodeUnit);
+
+    VERIFY(ranges.size() <= MaxRangesForVectorizedScan);
+
+    // Ranges are clamped to what a single code unit can hold; anything beyond that can never match one.
+    Array<VectorType, MaxRangesForVectorizedScan> lower_bounds;
+    Array<VectorType, MaxRangesForVectorizedScan> upper_bounds;
+    Array<CodeUnit, MaxRangesForVectorizedScan> lower_code_units;
+    Array<CodeUnit, MaxRangesForVectorizedScan> upper_code_units;
+    size_t range_count = 0;
+    for (auto range : ranges) {
+        if (range.from > NumericLimits<CodeUnit>::max())
+            continue;
+        auto from_code_unit = static_cast<CodeUnit>(range.from);
+        auto to_code_unit = static_cast<CodeUnit>(min(range.to, static_cast<u32>(NumericLimits<CodeUnit>::max())));
+        lower_bounds[range_count] = VectorType {} + from_code_unit;
+        upper_bounds[range_count] = VectorType {} + to_code_unit;
+        lower_code_units[range_count] = from_code_unit;
+        upper_code_units[range_count] = to_code_unit;
+        ++range_count;
+    }
+    if (range_count == 0)
+        return {};
+
+    size_t position = from;
+    for (; position + lane_count <= haystack.size(); position += lane_count) {
+        auto chunk = AK::SIMD::load_unaligned<VectorType>(haystack.data() + position);
+        auto in_range = (chunk >= lower_bounds[0]) & (chunk <= upper_bounds[0]);
+        for (size_t i = 1; i < range_count; ++i)
+            in_range |= (chunk >= lower_bounds[i]) & (chunk <= upper_bounds[i]);
+        if (auto lane = first_set_lane<CodeUnit>(in_range); lane.has_value())
+            return position + *lane;
+    }
+
+    for (; position < haystack.size(); ++position) {
+        auto code_unit = haystack[position];
+        for (size_t i = 0; i < range_count; ++i) {
+            if (code_unit >= lower_code_units[i] && code_unit <= upper_code_units[i])
+                return position;
+        }
+    }
+    return {};
+}
+
+Optional<size_t> find_literal(RegexStringView const& view, StringView literal, size_t from)
+{
+    return view.visit_code_units([&](auto code_units) { return find_literal(code_units, literal, from); });
+}
+
+Optional<size_t> find_code_unit_in_ranges(RegexStringView const& view, ReadonlySpan<CharRange> ranges, size_t from)
+{
+    return view.visit_code_units([&](auto code_units) { return find_code_unit_in_ranges(code_units, ranges, from); });
+}
+
+}
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexMatch.h"
+
+#include <AK/Optional.h>
+#include <AK/Span.h>
+#include <AK/StringView.h>
+
+namespace regex {
+
+// Scanning for more ranges than this is slower than just looking each code unit up.
+static constexpr size_t MaxRangesForVectorizedScan = 8;
+
+// These work on code units, so they must only be used on non-unicode views, where positions are code unit offsets.
+
+// Returns the position of the first occurrence of the (ASCII) literal at or after `from`.
+Optional<size_t> find_literal(RegexStringView const&, StringView literal, size_t from);
+
+// Returns the position of the first code unit at or after `from` that falls into one of (at most MaxRangesForVectorizedScan) ranges.
+Optional<size_t> find_code_unit_in_ranges(RegexStringView const&, ReadonlySpan<CharRange> ranges, size_t from);
+
+}
@@ -244,7 +244,7 @@ PatternErrorOr<Component> Component::compile(Utf8View const& input, PatternParse
     // 6. Let regular expression be RegExpCreate(regular expression string, flags). If this throws an exception, catch
     //    it, and throw a TypeError.
     auto regex = make<Regex<ECMA262>>(regular_expression_string.to_byte_string(), flags);
-    if (regex->parser_result.error != regex::Error::NoError)
+    if (regex->parser_result->error != regex::Error::NoError)
         return ErrorInfo { MUST(String::formatted("RegExp compile error: {}", regex->error_string())) };
 
     // 7. Let pattern string be the result of running generate a pattern string given part list and options.
@@ -170,6 +170,8 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
                 if (!extern_.has<MemoryAddress>())
                     return "Expected memory import"sv;
                 auto other_mem_type = m_store.get(extern_.get<MemoryAddress>())->type();
+                if (mem_type.is_shared() != other_mem_type.is_shared())
+                    return ByteString::formatted("Memory import and extern do not match: {} vs {}", mem_type.is_shared() ? "shared"sv : "unshared"sv, other_mem_type.is_shared() ? "shared"sv : "unshared"sv);
                 if (other_mem_type.limits().is_subset_of(mem_type.limits()))
                     return {};
                 return ByteString::formatted("Memory import and extern do not match: {}-{} vs {}-{}", mem_type.limits().min(), mem_type.limits().max(), other_mem_type.limits().min(), other_mem_type.limits().max());
@@ -239,6 +241,7 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
     }
 
     BytecodeInterpreter interpreter(m_stack_info);
+    interpreter.set_dispatch_mode(m_dispatch_mode);
     auto handle = register_scoped(interpreter);
 
     for (auto& entry : module.global_section().entries()) {
@@ -492,6 +495,7 @@ Optional<InstantiationError> AbstractMachine::allocate_all_final_phase(Module co
 Result AbstractMachine::invoke(FunctionAddress address, Vector<Value> arguments)
 {
     BytecodeInterpreter interpreter(m_stack_info);
+    interpreter.set_dispatch_mode(m_dispatch_mode);
     auto handle = register_scoped(interpreter);
     return invoke(interpreter, address, move(arguments));
 }
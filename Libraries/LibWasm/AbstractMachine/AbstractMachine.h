@@ -7,10 +7,12 @@
 #pragma once
 
 #include <AK/ByteBuffer.h>
+#include <AK/Debug.h>
 #include <AK/Function.h>
 #include <AK/HashMap.h>
 #include <AK/HashTable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/NumericLimits.h>
 #include <AK/StackInfo.h>
 #include <AK/UFixedBigInt.h>
 #include <LibWasm/Types.h>
@@ -419,6 +421,17 @@ public:
     {
         MemoryInstance instance { type };
 
+        // If the memory declares a maximum, reserve up to that much capacity up front so that growing doesn't have to move
+        // (and copy) the data. The reservation is capped, since each one counts against the commit charge (and a 32-bit
+        // address space) whether or not the pages are ever touched. Failing to reserve is not an error; the buffer is then
+        // simply grown on demand.
+        if (auto max = type.limits().max(); max.has_value()) {
+            u64 max_size = static_cast<u64>(max.value()) * Constants::page_size;
+            auto reservation_size = static_cast<size_t>(min(max_size, max_up_front_reservation_size));
+            if (instance.m_data.try_ensure_capacity(reservation_size).is_error())
+                dbgln_if(WASM_TRACE_DEBUG, "Failed to reserve {} bytes for a memory, growing it on demand instead", reservation_size);
+        }
+
         if (!instance.grow(type.limits().min() * Constants::page_size, GrowType::No))
             return Error::from_string_literal("Failed to grow to requested size");
 
@@ -469,7 +482,7 @@ public:
             //
             // See relevant spec link:
             // https://www.w3.org/TR/wasm-core-2/#growing-memories%E2%91%A0
-            m_type = MemoryType { Limits(m_type.limits().min() + size_to_grow / Constants::page_size, m_type.limits().max()) };
+            m_type = MemoryType { Limits(m_type.limits().min() + size_to_grow / Constants::page_size, m_type.limits().max()), m_type.is_shared() };
         }
 
         return true;
@@ -478,6 +491,8 @@ public:
     Function<void()> successful_grow_hook;
 
 private:
+    static constexpr u64 max_up_front_reservation_size = sizeof(FlatPtr) == 8 ? 64 * MiB : 8 * MiB;
+
     explicit MemoryInstance(MemoryType const& type)
         : m_type(type)
     {
@@ -624,6 +639,14 @@ struct HostVisitOps {
     Function<void(ExternallyManagedTrap&)> visit_trap;
 };
 
+// How the bytecode interpreter finds the handler for the next instruction.
+enum class DispatchMode {
+    // Jump straight from handler to handler through the pre-decoded instructions.
+    Threaded,
+    // Look up every instruction in one big switch. Slower, but useful as a reference to compare against.
+    Switch,
+};
+
 class AbstractMachine {
 public:
     explicit AbstractMachine() = default;
@@ -639,6 +662,7 @@ public:
     auto& store() { return m_store; }
 
     void enable_instruction_count_limit() { m_should_limit_instruction_count = true; }
+    void set_dispatch_mode(DispatchMode mode) { m_dispatch_mode = mode; }
 
     void visit_external_resources(HostVisitOps const&);
 
@@ -673,6 +697,7 @@ private:
     StackInfo m_stack_info;
     HashTable<Interpreter*> m_active_interpreters;
     bool m_should_limit_instruction_count { false };
+    DispatchMode m_dispatch_mode { DispatchMode::Threaded };
 };
 
 class Linker {
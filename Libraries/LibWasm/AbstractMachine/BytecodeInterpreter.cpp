@@ -33,6 +33,205 @@ namespace Wasm {
 void BytecodeInterpreter::interpret(Configuration& configuration)
 {
     m_trap = Empty {};
+
+    auto& expression = configuration.frame().expression();
+    if (auto const& stack_usage = expression.stack_usage_hint(); stack_usage.has_value()) {
+        // Validation told us exactly how much stack space we need, so the stacks never have to grow while we run.
+        configuration.value_stack().ensure_capacity(configuration.value_stack().size() + stack_usage->values);
+        configuration.label_stack().ensure_capacity(configuration.label_stack().size() + stack_usage->labels);
+    }
+
+    if (m_dispatch_mode == DispatchMode::Switch)
+        return interpret_with_switch_dispatch(configuration);
+
+    auto const* instructions = expression.instructions().data();
+    auto const* compiled_instructions = expression.compiled_instructions().data();
+    auto& ip = configuration.ip();
+
+    static void* const handlers[] = {
+        &&handle_Generic,
+#define __DECLARE_HANDLER(name) &&handle_##name,
+        ENUMERATE_WASM_COMPILED_INSTRUCTIONS(__DECLARE_HANDLER)
+#undef __DECLARE_HANDLER
+        &&handle_End,
+    };
+
+    // When instructions have to be counted, every dispatch goes through count_instruction first,
+    // so the handlers themselves don't need to know about it.
+    static void* const counting_handlers[] = {
+        &&count_instruction,
+#define __DECLARE_COUNTING_HANDLER(name) &&count_instruction,
+        ENUMERATE_WASM_COMPILED_INSTRUCTIONS(__DECLARE_COUNTING_HANDLER)
+#undef __DECLARE_COUNTING_HANDLER
+        &&handle_End,
+    };
+
+    auto* const* dispatch_table = configuration.should_limit_instruction_count() ? counting_handlers : handlers;
+    u64 executed_instructions = 0;
+
+#define DISPATCH_CURRENT_INSTRUCTION() \
+    goto* dispatch_table[to_underlying(compiled_instructions[ip.value()].kind)]
+
+#define DISPATCH_NEXT_INSTRUCTION()     \
+    do {                                \
+        ++ip;                           \
+        DISPATCH_CURRENT_INSTRUCTION(); \
+    } while (false)
+
+#define IMMEDIATE() compiled_instructions[ip.value()].immediate
+
+#define MEMORY_ARGUMENT() \
+    Instruction::MemoryArgument { 0, static_cast<u32>(IMMEDIATE()), MemoryIndex { 0 } }
+
+#define HANDLE_BINARY_NUMERIC_OPERATION(name, ...)                         \
+    handle_##name:                                                         \
+    binary_numeric_operation<__VA_ARGS__>(configuration);                  \
+    DISPATCH_NEXT_INSTRUCTION();
+
+    DISPATCH_CURRENT_INSTRUCTION();
+
+count_instruction:
+    if (executed_instructions++ >= Constants::max_allowed_executed_instructions_per_call) [[unlikely]] {
+        m_trap = Trap::from_string("Exceeded maximum allowed number of instructions");
+        return;
+    }
+    goto* handlers[to_underlying(compiled_instructions[ip.value()].kind)];
+
+handle_Generic: {
+    auto old_ip = ip;
+    interpret_instruction(configuration, ip, instructions[ip.value()]);
+    if (did_trap())
+        return;
+    if (ip == old_ip) // If no jump occurred
+        ++ip;
+    DISPATCH_CURRENT_INSTRUCTION();
+}
+
+handle_End:
+    return;
+
+handle_local_get:
+    configuration.value_stack().append(configuration.frame().locals()[IMMEDIATE()]);
+    DISPATCH_NEXT_INSTRUCTION();
+
+handle_local_set:
+    configuration.frame().locals()[IMMEDIATE()] = configuration.value_stack().take_last();
+    DISPATCH_NEXT_INSTRUCTION();
+
+handle_local_tee:
+    configuration.frame().locals()[IMMEDIATE()] = configuration.value_stack().last();
+    DISPATCH_NEXT_INSTRUCTION();
+
+handle_i32_const:
+    configuration.value_stack().append(Value(static_cast<i32>(IMMEDIATE())));
+    DISPATCH_NEXT_INSTRUCTION();
+
+handle_i64_const:
+    configuration.value_stack().append(Value(static_cast<i64>(IMMEDIATE())));
+    DISPATCH_NEXT_INSTRUCTION();
+
+handle_drop:
+    configuration.value_stack().take_last();
+    DISPATCH_NEXT_INSTRUCTION();
+
+handle_br:
+    branch_to_label(configuration, LabelIndex { IMMEDIATE() });
+    DISPATCH_CURRENT_INSTRUCTION();
+
+handle_br_if:
+    if (configuration.value_stack().take_last().to<i32>() == 0)
+        DISPATCH_NEXT_INSTRUCTION();
+    branch_to_label(configuration, LabelIndex { IMMEDIATE() });
+    DISPATCH_CURRENT_INSTRUCTION();
+
+handle_structured_end:
+    configuration.label_stack().take_last();
+    DISPATCH_NEXT_INSTRUCTION();
+
+handle_i32_load:
+    load_and_push<i32, i32>(configuration, MEMORY_ARGUMENT());
+    if (did_trap())
+        return;
+    DISPATCH_NEXT_INSTRUCTION();
+
+handle_i64_load:
+    load_and_push<i64, i64>(configuration, MEMORY_ARGUMENT());
+    if (did_trap())
+        return;
+    DISPATCH_NEXT_INSTRUCTION();
+
+handle_f32_load:
+    load_and_push<float, float>(configuration, MEMORY_ARGUMENT());
+    if (did_trap())
+        return;
+    DISPATCH_NEXT_INSTRUCTION();
+
+handle_f64_load:
+    load_and_push<double, double>(configuration, MEMORY_ARGUMENT());
+    if (did_trap())
+        return;
+    DISPATCH_NEXT_INSTRUCTION();
+
+handle_i32_store:
+    pop_and_store<i32, i32>(configuration, MEMORY_ARGUMENT());
+    if (did_trap())
+        return;
+    DISPATCH_NEXT_INSTRUCTION();
+
+handle_i64_store:
+    pop_and_store<i64, i64>(configuration, MEMORY_ARGUMENT());
+    if (did_trap())
+        return;
+    DISPATCH_NEXT_INSTRUCTION();
+
+handle_f32_store:
+    pop_and_store<float, float>(configuration, MEMORY_ARGUMENT());
+    if (did_trap())
+        return;
+    DISPATCH_NEXT_INSTRUCTION();
+
+handle_f64_store:
+    pop_and_store<double, double>(configuration, MEMORY_ARGUMENT());
+    if (did_trap())
+        return;
+    DISPATCH_NEXT_INSTRUCTION();
+
+handle_i32_eqz:
+    unary_operation<i32, i32, Operators::EqualsZero>(configuration);
+    DISPATCH_NEXT_INSTRUCTION();
+
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_eq, i32, i32, Operators::Equals)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_ne, i32, i32, Operators::NotEquals)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_lts, i32, i32, Operators::LessThan)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_ltu, u32, i32, Operators::LessThan)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_gts, i32, i32, Operators::GreaterThan)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_gtu, u32, i32, Operators::GreaterThan)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_les, i32, i32, Operators::LessThanOrEquals)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_leu, u32, i32, Operators::LessThanOrEquals)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_ges, i32, i32, Operators::GreaterThanOrEquals)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_geu, u32, i32, Operators::GreaterThanOrEquals)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_add, u32, i32, Operators::Add)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_sub, u32, i32, Operators::Subtract)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_mul, u32, i32, Operators::Multiply)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_and, i32, i32, Operators::BitAnd)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_or, i32, i32, Operators::BitOr)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_xor, i32, i32, Operators::BitXor)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_shl, u32, i32, Operators::BitShiftLeft)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_shrs, i32, i32, Operators::BitShiftRight)
+    HANDLE_BINARY_NUMERIC_OPERATION(i32_shru, u32, i32, Operators::BitShiftRight)
+    HANDLE_BINARY_NUMERIC_OPERATION(i64_add, u64, i64, Operators::Add)
+    HANDLE_BINARY_NUMERIC_OPERATION(i64_sub, u64, i64, Operators::Subtract)
+    HANDLE_BINARY_NUMERIC_OPERATION(i64_mul, u64, i64, Operators::Multiply)
+
+#undef HANDLE_BINARY_NUMERIC_OPERATION
+#undef MEMORY_ARGUMENT
+#undef IMMEDIATE
+#undef DISPATCH_NEXT_INSTRUCTION
+#undef DISPATCH_CURRENT_INSTRUCTION
+}
+
+void BytecodeInterpreter::interpret_with_switch_dispatch(Configuration& configuration)
+{
     auto& instructions = configuration.frame().expression().instructions();
     auto max_ip_value = InstructionPointer { instructions.size() };
     auto& current_ip_value = configuration.ip();
@@ -71,7 +270,12 @@ void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelInd
 template<typename ReadType, typename PushType>
 void BytecodeInterpreter::load_and_push(Configuration& configuration, Instruction const& instruction)
 {
-    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    load_and_push<ReadType, PushType>(configuration, instruction.arguments().get<Instruction::MemoryArgument>());
+}
+
+template<typename ReadType, typename PushType>
+void BytecodeInterpreter::load_and_push(Configuration& configuration, Instruction::MemoryArgument const& arg)
+{
     auto& address = configuration.frame().module().memories()[arg.memory_index.value()];
     auto memory = configuration.store().get(address);
     auto& entry = configuration.value_stack().last();
@@ -83,8 +287,7 @@ void BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
-    auto slice = memory->data().bytes().slice(instance_address, sizeof(ReadType));
-    entry = Value(static_cast<PushType>(read_value<ReadType>(slice)));
+    entry = Value(static_cast<PushType>(read_value<ReadType>(memory->data().data() + instance_address)));
 }
 
 template<typename TDst, typename TSrc>
@@ -173,8 +376,7 @@ void BytecodeInterpreter::load_and_push_m_splat(Configuration& configuration, In
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "vec-splat({} : {}) -> stack", instance_address, M / 8);
-    auto slice = memory->data().bytes().slice(instance_address, M / 8);
-    auto value = read_value<NativeIntegralType<M>>(slice);
+    auto value = read_value<NativeIntegralType<M>>(memory->data().data() + instance_address);
     set_top_m_splat<M, NativeIntegralType>(configuration, value);
 }
 
@@ -231,7 +433,11 @@ void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAdd
     FunctionType const* type { nullptr };
     instance->visit([&](auto const& function) { type = &function.type(); });
     Vector<Value> args;
-    args.ensure_capacity(type->parameters().size());
+    // The arguments become the callee's locals, so make room for the rest of them right away.
+    if (auto* wasm_function = instance->get_pointer<WasmFunction>())
+        args.ensure_capacity(type->parameters().size() + wasm_function->code().func().total_local_count());
+    else
+        args.ensure_capacity(type->parameters().size());
     auto span = configuration.value_stack().span().slice_from_end(type->parameters().size());
     for (auto& value : span)
         args.unchecked_append(value);
@@ -330,7 +536,12 @@ struct ConvertToRaw<double> {
 template<typename PopT, typename StoreT>
 void BytecodeInterpreter::pop_and_store(Configuration& configuration, Instruction const& instruction)
 {
-    auto& memarg = instruction.arguments().get<Instruction::MemoryArgument>();
+    pop_and_store<PopT, StoreT>(configuration, instruction.arguments().get<Instruction::MemoryArgument>());
+}
+
+template<typename PopT, typename StoreT>
+void BytecodeInterpreter::pop_and_store(Configuration& configuration, Instruction::MemoryArgument const& memarg)
+{
     auto entry = configuration.value_stack().take_last();
     auto value = ConvertToRaw<StoreT> {}(entry.to<PopT>());
     dbgln_if(WASM_TRACE_DEBUG, "stack({}) -> temporary({}b)", value, sizeof(StoreT));
@@ -361,41 +572,153 @@ void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruct
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "temporary({}b) -> store({})", data.size(), instance_address);
-    data.copy_to(memory->data().bytes().slice(instance_address, data.size()));
+    // The access was bounds-checked above, so copy straight into memory instead of going through a checked slice.
+    __builtin_memcpy(memory->data().data() + instance_address, data.data(), data.size());
+}
+
+template<typename T>
+T* BytecodeInterpreter::atomic_access_pointer(Configuration& configuration, Instruction::MemoryArgument const& arg, u32 base)
+{
+    auto& address = configuration.frame().module().memories()[arg.memory_index.value()];
+    auto memory = configuration.store().get(address);
+    u64 instance_address = static_cast<u64>(base) + arg.offset;
+    if (instance_address + sizeof(T) > memory->size()) {
+        m_trap = Trap::from_string("Memory access out of bounds");
+        dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + sizeof(T), memory->size());
+        return nullptr;
+    }
+    // The validator pins the alignment hint to the access size, but the effective address must be aligned too.
+    if (instance_address % sizeof(T) != 0) {
+        m_trap = Trap::from_string("Unaligned atomic memory access");
+        return nullptr;
+    }
+    return reinterpret_cast<T*>(memory->data().data() + instance_address);
+}
+
+template<typename AccessT, typename OperandT>
+void BytecodeInterpreter::atomic_load_and_push(Configuration& configuration, Instruction const& instruction)
+{
+    auto& entry = configuration.value_stack().last();
+    auto* pointer = atomic_access_pointer<AccessT>(configuration, instruction.arguments().get<Instruction::MemoryArgument>(), entry.to<u32>());
+    if (!pointer)
+        return;
+    entry = Value(static_cast<OperandT>(__atomic_load_n(pointer, __ATOMIC_SEQ_CST)));
+}
+
+template<typename AccessT, typename OperandT>
+void BytecodeInterpreter::atomic_pop_and_store(Configuration& configuration, Instruction const& instruction)
+{
+    auto value = static_cast<AccessT>(configuration.value_stack().take_last().to<OperandT>());
+    auto base = configuration.value_stack().take_last().to<u32>();
+    auto* pointer = atomic_access_pointer<AccessT>(configuration, instruction.arguments().get<Instruction::MemoryArgument>(), base);
+    if (!pointer)
+        return;
+    __atomic_store_n(pointer, value, __ATOMIC_SEQ_CST);
+}
+
+template<typename AccessT, typename OperandT, AtomicOperation operation>
+void BytecodeInterpreter::atomic_read_modify_write(Configuration& configuration, Instruction const& instruction)
+{
+    auto operand = static_cast<AccessT>(configuration.value_stack().take_last().to<OperandT>());
+    auto& entry = configuration.value_stack().last();
+    auto* pointer = atomic_access_pointer<AccessT>(configuration, instruction.arguments().get<Instruction::MemoryArgument>(), entry.to<u32>());
+    if (!pointer)
+        return;
+
+    AccessT old_value;
+    if constexpr (operation == AtomicOperation::Add)
+        old_value = __atomic_fetch_add(pointer, operand, __ATOMIC_SEQ_CST);
+    else if constexpr (operation == AtomicOperation::Sub)
+        old_value = __atomic_fetch_sub(pointer, operand, __ATOMIC_SEQ_CST);
+    else if constexpr (operation == AtomicOperation::And)
+        old_value = __atomic_fetch_and(pointer, operand, __ATOMIC_SEQ_CST);
+    else if constexpr (operation == AtomicOperation::Or)
+        old_value = __atomic_fetch_or(pointer, operand, __ATOMIC_SEQ_CST);
+    else if constexpr (operation == AtomicOperation::Xor)
+        old_value = __atomic_fetch_xor(pointer, operand, __ATOMIC_SEQ_CST);
+    else
+        old_value = __atomic_exchange_n(pointer, operand, __ATOMIC_SEQ_CST);
+    entry = Value(static_cast<OperandT>(old_value));
+}
+
+template<typename AccessT, typename OperandT>
+void BytecodeInterpreter::atomic_compare_exchange(Configuration& configuration, Instruction const& instruction)
+{
+    auto replacement = static_cast<AccessT>(configuration.value_stack().take_last().to<OperandT>());
+    // Only the low bits of the expected value take part in the comparison, as with the narrow loads.
+    auto expected = static_cast<AccessT>(configuration.value_stack().take_last().to<OperandT>());
+    auto& entry = configuration.value_stack().last();
+    auto* pointer = atomic_access_pointer<AccessT>(configuration, instruction.arguments().get<Instruction::MemoryArgument>(), entry.to<u32>());
+    if (!pointer)
+        return;
+    // On failure, `expected` is updated with the current value, so it always ends up holding the old value.
+    __atomic_compare_exchange_n(pointer, &expected, replacement, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    entry = Value(static_cast<OperandT>(expected));
 }
 
+// https://webassembly.github.io/threads/core/exec/instructions.html#exec-memory-atomic-wait
 template<typename T>
-T BytecodeInterpreter::read_value(ReadonlyBytes data)
+void BytecodeInterpreter::atomic_wait(Configuration& configuration, Instruction const& instruction)
 {
-    FixedMemoryStream stream { data };
-    auto value_or_error = stream.read_value<LittleEndian<T>>();
-    if (value_or_error.is_error()) {
-        dbgln("Read from {} failed", data.data());
-        m_trap = Trap::from_string("Read from memory failed");
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    auto timeout = configuration.value_stack().take_last().to<i64>();
+    auto expected = configuration.value_stack().take_last().to<T>();
+    auto& entry = configuration.value_stack().last();
+    auto* pointer = atomic_access_pointer<T>(configuration, arg, entry.to<u32>());
+    if (!pointer)
+        return;
+
+    auto& address = configuration.frame().module().memories()[arg.memory_index.value()];
+    TRAP_IF_NOT(configuration.store().get(address)->type().is_shared());
+
+    // "not-equal"
+    if (__atomic_load_n(pointer, __ATOMIC_SEQ_CST) != expected) {
+        entry = Value(static_cast<i32>(1));
+        return;
     }
-    return value_or_error.release_value();
+
+    // FIXME: Memories can't be shared between agents yet, so nothing could ever notify us. Like Atomics.wait() on an
+    //        agent that can't block, trap rather than suspending this thread (which may well be the one running the page).
+    if (timeout != 0) {
+        m_trap = Trap::from_string("Waiting on a memory that no other agent can notify");
+        return;
+    }
+
+    // "timed-out"
+    entry = Value(static_cast<i32>(2));
+}
+
+// https://webassembly.github.io/threads/core/exec/instructions.html#exec-memory-atomic-notify
+void BytecodeInterpreter::atomic_notify(Configuration& configuration, Instruction const& instruction)
+{
+    configuration.value_stack().take_last(); // count
+    auto& entry = configuration.value_stack().last();
+    if (!atomic_access_pointer<u32>(configuration, instruction.arguments().get<Instruction::MemoryArgument>(), entry.to<u32>()))
+        return;
+
+    // FIXME: Memories can't be shared between agents yet, so there is never anyone waiting to be woken up.
+    entry = Value(static_cast<i32>(0));
+}
+
+// NOTE: Callers must have bounds-checked the access against the memory's size already.
+template<typename T>
+T BytecodeInterpreter::read_value(u8 const* data)
+{
+    LittleEndian<T> value;
+    __builtin_memcpy(&value, data, sizeof(value));
+    return value;
 }
 
 template<>
-float BytecodeInterpreter::read_value<float>(ReadonlyBytes data)
+float BytecodeInterpreter::read_value<float>(u8 const* data)
 {
-    FixedMemoryStream stream { data };
-    auto raw_value_or_error = stream.read_value<LittleEndian<u32>>();
-    if (raw_value_or_error.is_error())
-        m_trap = Trap::from_string("Read from memory failed");
-    auto raw_value = raw_value_or_error.release_value();
-    return bit_cast<float>(static_cast<u32>(raw_value));
+    return bit_cast<float>(read_value<u32>(data));
 }
 
 template<>
-double BytecodeInterpreter::read_value<double>(ReadonlyBytes data)
+double BytecodeInterpreter::read_value<double>(u8 const* data)
 {
-    FixedMemoryStream stream { data };
-    auto raw_value_or_error = stream.read_value<LittleEndian<u64>>();
-    if (raw_value_or_error.is_error())
-        m_trap = Trap::from_string("Read from memory failed");
-    auto raw_value = raw_value_or_error.release_value();
-    return bit_cast<double>(static_cast<u64>(raw_value));
+    return bit_cast<double>(read_value<u64>(data));
 }
 
 ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
@@ -1155,6 +1478,35 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
     case Instructions::v128_const.value():
         configuration.value_stack().append(Value(instruction.arguments().get<u128>()));
         return;
+    case Instructions::memory_atomic_notify.value():
+        return atomic_notify(configuration, instruction);
+    case Instructions::memory_atomic_wait32.value():
+        return atomic_wait<u32>(configuration, instruction);
+    case Instructions::memory_atomic_wait64.value():
+        return atomic_wait<u64>(configuration, instruction);
+    case Instructions::atomic_fence.value():
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        return;
+#define M(name, access_width, operand_width) \
+    case Instructions::name.value():         \
+        return atomic_load_and_push<NativeIntegralType<access_width>, NativeIntegralType<operand_width>>(configuration, instruction);
+        ENUMERATE_WASM_ATOMIC_LOAD_OPCODES(M)
+#undef M
+#define M(name, access_width, operand_width) \
+    case Instructions::name.value():         \
+        return atomic_pop_and_store<NativeIntegralType<access_width>, NativeIntegralType<operand_width>>(configuration, instruction);
+        ENUMERATE_WASM_ATOMIC_STORE_OPCODES(M)
+#undef M
+#define M(name, access_width, operand_width, operation) \
+    case Instructions::name.value():                    \
+        return atomic_read_modify_write<NativeIntegralType<access_width>, NativeIntegralType<operand_width>, AtomicOperation::operation>(configuration, instruction);
+        ENUMERATE_WASM_ATOMIC_RMW_OPCODES(M)
+#undef M
+#define M(name, access_width, operand_width) \
+    case Instructions::name.value():         \
+        return atomic_compare_exchange<NativeIntegralType<access_width>, NativeIntegralType<operand_width>>(configuration, instruction);
+        ENUMERATE_WASM_ATOMIC_CMPXCHG_OPCODES(M)
+#undef M
     case Instructions::v128_load.value():
         return load_and_push<u128, u128>(configuration, instruction);
     case Instructions::v128_load8x8_s.value():
@@ -12,6 +12,15 @@
 
 namespace Wasm {
 
+enum class AtomicOperation {
+    Add,
+    Sub,
+    And,
+    Or,
+    Xor,
+    Exchange,
+};
+
 struct BytecodeInterpreter : public Interpreter {
     explicit BytecodeInterpreter(StackInfo const& stack_info)
         : m_stack_info(stack_info)
@@ -20,6 +29,8 @@ struct BytecodeInterpreter : public Interpreter {
 
     virtual void interpret(Configuration&) final;
 
+    void set_dispatch_mode(DispatchMode mode) { m_dispatch_mode = mode; }
+
     virtual ~BytecodeInterpreter() override = default;
     virtual bool did_trap() const final { return !m_trap.has<Empty>(); }
     virtual Trap trap() const final
@@ -48,12 +59,17 @@ struct BytecodeInterpreter : public Interpreter {
     };
 
 protected:
+    void interpret_with_switch_dispatch(Configuration&);
     void interpret_instruction(Configuration&, InstructionPointer&, Instruction const&);
     void branch_to_label(Configuration&, LabelIndex);
     template<typename ReadT, typename PushT>
     void load_and_push(Configuration&, Instruction const&);
+    template<typename ReadT, typename PushT>
+    void load_and_push(Configuration&, Instruction::MemoryArgument const&);
     template<typename PopT, typename StoreT>
     void pop_and_store(Configuration&, Instruction const&);
+    template<typename PopT, typename StoreT>
+    void pop_and_store(Configuration&, Instruction::MemoryArgument const&);
     template<size_t N>
     void pop_and_store_lane_n(Configuration&, Instruction const&);
     template<size_t M, size_t N, template<typename> typename SetSign>
@@ -71,6 +87,19 @@ protected:
     template<typename M, template<typename> typename SetSign, typename VectorType = Native128ByteVectorOf<M, SetSign>>
     VectorType pop_vector(Configuration&);
     void store_to_memory(Configuration&, Instruction::MemoryArgument const&, ReadonlyBytes data, u32 base);
+    template<typename T>
+    T* atomic_access_pointer(Configuration&, Instruction::MemoryArgument const&, u32 base);
+    template<typename AccessT, typename OperandT>
+    void atomic_load_and_push(Configuration&, Instruction const&);
+    template<typename AccessT, typename OperandT>
+    void atomic_pop_and_store(Configuration&, Instruction const&);
+    template<typename AccessT, typename OperandT, AtomicOperation>
+    void atomic_read_modify_write(Configuration&, Instruction const&);
+    template<typename AccessT, typename OperandT>
+    void atomic_compare_exchange(Configuration&, Instruction const&);
+    template<typename T>
+    void atomic_wait(Configuration&, Instruction const&);
+    void atomic_notify(Configuration&, Instruction const&);
     void call_address(Configuration&, FunctionAddress);
 
     template<typename PopTypeLHS, typename PushType, typename Operator, typename PopTypeRHS = PopTypeLHS, typename... Args>
@@ -80,7 +109,7 @@ protected:
     void unary_operation(Configuration&, Args&&...);
 
     template<typename T>
-    T read_value(ReadonlyBytes data);
+    static T read_value(u8 const* data);
 
     ALWAYS_INLINE bool trap_if_not(bool value, StringView reason)
     {
@@ -91,6 +120,7 @@ protected:
 
     Variant<Trap, Empty> m_trap;
     StackInfo const& m_stack_info;
+    DispatchMode m_dispatch_mode { DispatchMode::Threaded };
 };
 
 struct DebuggerBytecodeInterpreter : public BytecodeInterpreter {
@@ -25,10 +25,10 @@ Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Ve
         return Trap::from_string("Attempt to call nonexistent function by address");
     if (auto* wasm_function = function->get_pointer<WasmFunction>()) {
         Vector<Value> locals = move(arguments);
-        locals.ensure_capacity(locals.size() + wasm_function->code().func().locals().size());
+        locals.ensure_capacity(locals.size() + wasm_function->code().func().total_local_count());
         for (auto& local : wasm_function->code().func().locals()) {
             for (size_t i = 0; i < local.n(); ++i)
-                locals.append(Value(local.type()));
+                locals.unchecked_append(Value(local.type()));
         }
 
         set_frame(Frame {
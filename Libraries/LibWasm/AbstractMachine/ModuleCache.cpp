@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWasm/AbstractMachine/ModuleCache.h>
+
+namespace Wasm {
+
+static size_t estimated_memory_usage(Expression const& expression)
+{
+    return expression.instructions().capacity() * sizeof(Instruction)
+        + expression.compiled_instructions().capacity() * sizeof(Expression::CompiledInstruction);
+}
+
+// Parsed modules are dominated by their instructions and data segments, so this ignores the smaller bits.
+static size_t estimated_memory_usage(Module const& module)
+{
+    size_t size = sizeof(Module);
+    for (auto& section : module.custom_sections())
+        size += sizeof(section) + section.contents().size();
+    for (auto& global : module.global_section().entries())
+        size += sizeof(global) + estimated_memory_usage(global.expression());
+    for (auto& segment : module.element_section().segments()) {
+        size += sizeof(segment);
+        for (auto& expression : segment.init)
+            size += sizeof(expression) + estimated_memory_usage(expression);
+    }
+    for (auto& code : module.code_section().functions())
+        size += sizeof(code) + code.func().locals().capacity() * sizeof(Locals) + estimated_memory_usage(code.func().body());
+    for (auto& data : module.data_section().data()) {
+        size += sizeof(data);
+        data.value().visit(
+            [&](DataSection::Data::Passive const& passive) { size += passive.init.capacity(); },
+            [&](DataSection::Data::Active const& active) { size += active.init.capacity() + estimated_memory_usage(active.offset); });
+    }
+    return size;
+}
+
+void ModuleCache::set_capacity_in_bytes(size_t capacity)
+{
+    m_capacity_in_bytes = capacity;
+    evict_until_size_is_at_most(capacity);
+}
+
+RefPtr<Module> ModuleCache::find(ReadonlyBytes binary)
+{
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        // NOTE: We compare the full binary rather than trusting a hash, since a false positive would run the wrong code.
+        if (m_entries[i].binary.bytes() != binary)
+            continue;
+
+        auto hit = m_entries.take(i);
+        auto module = hit.module;
+        m_entries.append(move(hit));
+        return module;
+    }
+    return nullptr;
+}
+
+void ModuleCache::add(ReadonlyBytes binary, NonnullRefPtr<Module> module)
+{
+    VERIFY(module->validation_status() == Module::ValidationStatus::Valid);
+
+    auto size = binary.size() + estimated_memory_usage(*module);
+    if (size > m_capacity_in_bytes)
+        return;
+
+    auto binary_copy = ByteBuffer::copy(binary);
+    if (binary_copy.is_error())
+        return;
+
+    evict_until_size_is_at_most(m_capacity_in_bytes - size);
+    m_entries.append({ binary_copy.release_value(), move(module), size });
+    m_size_in_bytes += size;
+}
+
+void ModuleCache::clear()
+{
+    m_entries.clear();
+    m_size_in_bytes = 0;
+}
+
+void ModuleCache::evict_until_size_is_at_most(size_t size)
+{
+    while (m_size_in_bytes > size) {
+        auto evicted = m_entries.take_first();
+        m_size_in_bytes -= evicted.size_in_bytes;
+    }
+}
+
+}
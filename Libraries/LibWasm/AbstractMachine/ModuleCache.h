@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Vector.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+// Keeps recently compiled modules around, keyed by their binary, so that compiling the exact same bytes again
+// (e.g. the same application on every visit) can skip both parsing and validation.
+// The capacity limits the memory an entry retains: its copy of the binary, plus an estimate of the parsed module.
+//
+// NOTE: Modules are reference counted without atomics, so a cache must only ever be used from a single thread.
+class ModuleCache {
+    AK_MAKE_NONCOPYABLE(ModuleCache);
+    AK_MAKE_NONMOVABLE(ModuleCache);
+
+public:
+    // A capacity of 0 (the default) disables the cache.
+    explicit ModuleCache(size_t capacity_in_bytes = 0)
+        : m_capacity_in_bytes(capacity_in_bytes)
+    {
+    }
+
+    void set_capacity_in_bytes(size_t);
+    size_t capacity_in_bytes() const { return m_capacity_in_bytes; }
+    size_t size_in_bytes() const { return m_size_in_bytes; }
+
+    RefPtr<Module> find(ReadonlyBytes binary);
+
+    // Only modules that have been validated successfully are added.
+    void add(ReadonlyBytes binary, NonnullRefPtr<Module>);
+
+    void clear();
+
+private:
+    struct Entry {
+        ByteBuffer binary;
+        NonnullRefPtr<Module> module;
+        size_t size_in_bytes { 0 };
+    };
+
+    void evict_until_size_is_at_most(size_t);
+
+    // Ordered from least to most recently used.
+    Vector<Entry> m_entries;
+    size_t m_size_in_bytes { 0 };
+    size_t m_capacity_in_bytes { 0 };
+};
+
+}
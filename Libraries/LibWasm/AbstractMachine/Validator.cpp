@@ -9,6 +9,7 @@
 #include <AK/TemporaryChange.h>
 #include <AK/Try.h>
 #include <LibWasm/AbstractMachine/Validator.h>
+#include <LibWasm/Parallel.h>
 #include <LibWasm/Printer/Printer.h>
 
 namespace Wasm {
@@ -239,29 +240,74 @@ ErrorOr<void, ValidationError> Validator::validate(TableSection const& section)
     return {};
 }
 
-ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
+ErrorOr<void, ValidationError> Validator::validate(CodeSection& section)
 {
+    auto& functions = section.functions();
+
+    // NOTE: Forked validators share context data through non-atomic reference counts, so they're all set up (and torn down)
+    //       on this thread. Validating the function bodies only reads that shared data, so it can happen in parallel.
+    //       This includes building error messages, which only look at the static instruction names through views.
+    Vector<NonnullOwnPtr<Validator>> function_validators;
+    function_validators.ensure_capacity(functions.size());
+    size_t code_size = 0;
     size_t index = m_context.imported_function_count;
-    for (auto& entry : section.functions()) {
+    Optional<ValidationError> function_index_error;
+    for (auto& entry : functions) {
         auto function_index = index++;
-        TRY(validate(FunctionIndex { function_index }));
+        if (auto result = validate(FunctionIndex { function_index }); result.is_error()) {
+            // Validating one function after another would only have gotten this far, so only the bodies before this one
+            // are validated, and their errors take precedence.
+            function_index_error = result.release_error();
+            break;
+        }
         auto& function_type = m_context.functions[function_index];
         auto& function = entry.func();
 
         auto function_validator = fork();
-        function_validator.m_context.locals = {};
-        function_validator.m_context.locals.extend(function_type.parameters());
+        function_validator->m_context.locals = {};
+        function_validator->m_context.locals.extend(function_type.parameters());
         for (auto& local : function.locals()) {
             for (size_t i = 0; i < local.n(); ++i)
-                function_validator.m_context.locals.append(local.type());
+                function_validator->m_context.locals.append(local.type());
         }
 
-        function_validator.m_frames.empend(function_type, FrameKind::Function, (size_t)0);
+        function_validator->m_frames.empend(function_type, FrameKind::Function, (size_t)0);
+        function_validators.unchecked_append(move(function_validator));
+        code_size += entry.size();
+    }
+
+    auto function_count = function_validators.size();
+    Vector<Optional<ValidationError>> errors;
+    errors.resize(function_count);
+    auto validate_function = [&](size_t function_offset) {
+        auto& function_type = m_context.functions[m_context.imported_function_count + function_offset];
+        auto& body = functions[function_offset].func().body();
+        auto results = function_validators[function_offset]->validate(body, function_type.results());
+        if (results.is_error())
+            errors[function_offset] = results.release_error();
+        else if (results.value().result_types.size() != function_type.results().size())
+            errors[function_offset] = Errors::invalid("function result"sv, function_type.results(), results.value().result_types);
+        else
+            body.set_stack_usage_hint(results.value().stack_usage);
+        return errors[function_offset].has_value() ? IterationDecision::Break : IterationDecision::Continue;
+    };
+
+    if (code_size >= minimum_code_size_for_parallel_compilation) {
+        for_each_index_in_parallel(function_count, validate_function);
+    } else {
+        for (size_t i = 0; i < function_count; ++i) {
+            if (validate_function(i) == IterationDecision::Break)
+                break;
+        }
+    }
 
-        auto results = TRY(function_validator.validate(function.body(), function_type.results()));
-        if (results.result_types.size() != function_type.results().size())
-            return Errors::invalid("function result"sv, function_type.results(), results.result_types);
+    // Functions are handed out in order, so this is the same error validating them one after another would have found.
+    for (auto& error : errors) {
+        if (error.has_value())
+            return error.release_value();
     }
+    if (function_index_error.has_value())
+        return function_index_error.release_value();
 
     return {};
 }
@@ -273,6 +319,10 @@ ErrorOr<void, ValidationError> Validator::validate(TableType const& type)
 
 ErrorOr<void, ValidationError> Validator::validate(MemoryType const& type)
 {
+    // Proposal "threads", shared memories can't be resized past a fixed bound, so they must declare a maximum.
+    if (type.is_shared() && !type.limits().max().has_value())
+        return Errors::invalid("shared memory without a maximum"sv);
+
     return validate(type.limits(), 1 << 16);
 }
 
@@ -3682,6 +3732,96 @@ VALIDATE_INSTRUCTION(f64x2_convert_low_i32x4_u)
     return stack.take_and_put<ValueType::V128>(ValueType::V128);
 }
 
+ErrorOr<void, ValidationError> Validator::validate_atomic_memory_argument(Instruction::MemoryArgument const& arg, size_t access_width) const
+{
+    TRY(validate(arg.memory_index));
+
+    // Proposal "threads", unlike other memory accesses, atomic ones must declare exactly their natural alignment.
+    if ((1ull << arg.align) != access_width / 8)
+        return Errors::invalid("atomic memory op alignment"sv, access_width / 8, 1ull << arg.align);
+
+    return {};
+}
+
+VALIDATE_INSTRUCTION(memory_atomic_notify)
+{
+    TRY(validate_atomic_memory_argument(instruction.arguments().get<Instruction::MemoryArgument>(), 32));
+
+    TRY((stack.take<ValueType::I32, ValueType::I32>()));
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(memory_atomic_wait32)
+{
+    TRY(validate_atomic_memory_argument(instruction.arguments().get<Instruction::MemoryArgument>(), 32));
+
+    TRY((stack.take<ValueType::I64, ValueType::I32, ValueType::I32>()));
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(memory_atomic_wait64)
+{
+    TRY(validate_atomic_memory_argument(instruction.arguments().get<Instruction::MemoryArgument>(), 64));
+
+    TRY((stack.take<ValueType::I64, ValueType::I64, ValueType::I32>()));
+    stack.append(ValueType(ValueType::I32));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(atomic_fence)
+{
+    return {};
+}
+
+#define OPERAND_TYPE(width) ((width) == 32 ? ValueType::I32 : ValueType::I64)
+
+#define M(name, access_width, operand_width)                                                                                \
+    VALIDATE_INSTRUCTION(name)                                                                                              \
+    {                                                                                                                       \
+        TRY(validate_atomic_memory_argument(instruction.arguments().get<Instruction::MemoryArgument>(), access_width)); \
+        TRY((stack.take<ValueType::I32>()));                                                                                \
+        stack.append(ValueType(OPERAND_TYPE(operand_width)));                                                               \
+        return {};                                                                                                          \
+    }
+ENUMERATE_WASM_ATOMIC_LOAD_OPCODES(M)
+#undef M
+
+#define M(name, access_width, operand_width)                                                                                \
+    VALIDATE_INSTRUCTION(name)                                                                                              \
+    {                                                                                                                       \
+        TRY(validate_atomic_memory_argument(instruction.arguments().get<Instruction::MemoryArgument>(), access_width)); \
+        TRY((stack.take<OPERAND_TYPE(operand_width), ValueType::I32>()));                                                   \
+        return {};                                                                                                          \
+    }
+ENUMERATE_WASM_ATOMIC_STORE_OPCODES(M)
+#undef M
+
+#define M(name, access_width, operand_width, operation)                                                                     \
+    VALIDATE_INSTRUCTION(name)                                                                                              \
+    {                                                                                                                       \
+        TRY(validate_atomic_memory_argument(instruction.arguments().get<Instruction::MemoryArgument>(), access_width)); \
+        TRY((stack.take<OPERAND_TYPE(operand_width), ValueType::I32>()));                                                   \
+        stack.append(ValueType(OPERAND_TYPE(operand_width)));                                                               \
+        return {};                                                                                                          \
+    }
+ENUMERATE_WASM_ATOMIC_RMW_OPCODES(M)
+#undef M
+
+#define M(name, access_width, operand_width)                                                                                \
+    VALIDATE_INSTRUCTION(name)                                                                                              \
+    {                                                                                                                       \
+        TRY(validate_atomic_memory_argument(instruction.arguments().get<Instruction::MemoryArgument>(), access_width)); \
+        TRY((stack.take<OPERAND_TYPE(operand_width), OPERAND_TYPE(operand_width), ValueType::I32>()));                      \
+        stack.append(ValueType(OPERAND_TYPE(operand_width)));                                                               \
+        return {};                                                                                                          \
+    }
+ENUMERATE_WASM_ATOMIC_CMPXCHG_OPCODES(M)
+#undef M
+
+#undef OPERAND_TYPE
+
 ErrorOr<void, ValidationError> Validator::validate(Instruction const& instruction, Stack& stack, bool& is_constant)
 {
     switch (instruction.opcode().value()) {
@@ -3705,12 +3845,15 @@ ErrorOr<Validator::ExpressionTypeResult, ValidationError> Validator::validate(Ex
         m_frames.empend(FunctionType { {}, result_types }, FrameKind::Function, (size_t)0);
     auto stack = Stack(m_frames);
     bool is_constant_expression = true;
+    Expression::StackUsage stack_usage { 0, m_frames.size() };
 
     for (auto& instruction : expression.instructions()) {
         bool is_constant = false;
         TRY(validate(instruction, stack, is_constant));
 
         is_constant_expression &= is_constant;
+        stack_usage.values = max(stack_usage.values, stack.size());
+        stack_usage.labels = max(stack_usage.labels, m_frames.size());
     }
 
     auto expected_result_types = result_types;
@@ -3722,7 +3865,7 @@ ErrorOr<Validator::ExpressionTypeResult, ValidationError> Validator::validate(Ex
     m_frames.take_last();
     VERIFY(m_frames.is_empty());
 
-    return ExpressionTypeResult { stack.release_vector(), is_constant_expression };
+    return ExpressionTypeResult { stack.release_vector(), is_constant_expression, stack_usage };
 }
 
 ByteString Validator::Errors::find_instruction_name(SourceLocation const& location)
@@ -8,6 +8,7 @@
 
 #include <AK/COWVector.h>
 #include <AK/Debug.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/RedBlackTree.h>
 #include <AK/SourceLocation.h>
 #include <AK/Tuple.h>
@@ -52,9 +53,9 @@ class Validator {
 public:
     Validator() = default;
 
-    [[nodiscard]] Validator fork() const
+    [[nodiscard]] NonnullOwnPtr<Validator> fork() const
     {
-        return Validator { m_context };
+        return adopt_own(*new Validator { m_context });
     }
 
     // Module
@@ -67,7 +68,7 @@ public:
     ErrorOr<void, ValidationError> validate(GlobalSection const&);
     ErrorOr<void, ValidationError> validate(MemorySection const&);
     ErrorOr<void, ValidationError> validate(TableSection const&);
-    ErrorOr<void, ValidationError> validate(CodeSection const&);
+    ErrorOr<void, ValidationError> validate(CodeSection&);
     ErrorOr<void, ValidationError> validate(FunctionSection const&) { return {}; }
     ErrorOr<void, ValidationError> validate(DataCountSection const&) { return {}; }
     ErrorOr<void, ValidationError> validate(TypeSection const&) { return {}; }
@@ -94,6 +95,8 @@ public:
         return Errors::invalid("MemoryIndex"sv);
     }
 
+    ErrorOr<void, ValidationError> validate_atomic_memory_argument(Instruction::MemoryArgument const&, size_t access_width) const;
+
     ErrorOr<void, ValidationError> validate(ElementIndex index) const
     {
         if (index.value() < m_context.elements.size())
@@ -263,6 +266,7 @@ public:
     struct ExpressionTypeResult {
         Vector<StackEntry> result_types;
         bool is_constant { false };
+        Expression::StackUsage stack_usage;
     };
     ErrorOr<ExpressionTypeResult, ValidationError> validate(Expression const&, Vector<ValueType> const&);
     ErrorOr<void, ValidationError> validate(Instruction const& instruction, Stack& stack, bool& is_constant);
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/IterationDecision.h>
+#include <AK/Vector.h>
+#include <LibCore/System.h>
+#include <LibThreading/Thread.h>
+
+namespace Wasm {
+
+// Sections smaller than this are cheaper to process on the calling thread than to hand out to worker threads.
+static constexpr size_t minimum_code_size_for_parallel_compilation = 256 * KiB;
+static constexpr size_t max_parallel_compilation_threads = 8;
+
+// Calls `task` once for every index in [0, count), spread over the calling thread and a few short-lived worker threads.
+// Indices are handed out in increasing order, so once a task returns IterationDecision::Break, every lower index has
+// been (or is being) processed, and no higher index will be started.
+// Tasks run concurrently, so they must only touch state that belongs to their own index.
+template<typename Callback>
+void for_each_index_in_parallel(size_t count, Callback const& task)
+{
+    Atomic<size_t> next_index { 0 };
+    Atomic<bool> stop { false };
+
+    auto run_tasks = [&] {
+        while (!stop.load(AK::MemoryOrder::memory_order_relaxed)) {
+            auto index = next_index.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+            if (index >= count)
+                return;
+            if (task(index) == IterationDecision::Break)
+                stop.store(true, AK::MemoryOrder::memory_order_relaxed);
+        }
+    };
+
+    auto thread_count = min(min(static_cast<size_t>(Core::System::hardware_concurrency()), max_parallel_compilation_threads), count);
+
+    Vector<NonnullRefPtr<Threading::Thread>> workers;
+    for (size_t i = 1; i < thread_count; ++i) {
+        auto worker_or_error = Threading::Thread::try_create([&]() -> intptr_t {
+            run_tasks();
+            return 0;
+        },
+            "Wasm compiler"sv);
+        // Not being able to spawn a worker is fine, the remaining threads will just pick up its share.
+        if (worker_or_error.is_error())
+            break;
+        auto worker = worker_or_error.release_value();
+        worker->start();
+        workers.append(move(worker));
+    }
+
+    run_tasks();
+
+    for (auto& worker : workers)
+        (void)worker->join();
+}
+
+}
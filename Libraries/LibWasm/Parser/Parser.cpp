@@ -11,6 +11,7 @@
 #include <AK/MemoryStream.h>
 #include <AK/ScopeLogger.h>
 #include <AK/UFixedBigInt.h>
+#include <LibWasm/Parallel.h>
 #include <LibWasm/Types.h>
 
 namespace Wasm {
@@ -146,14 +147,8 @@ ParseResult<FunctionType> FunctionType::parse(Stream& stream)
     return FunctionType { parameters_result, results_result };
 }
 
-ParseResult<Limits> Limits::parse(Stream& stream)
+static ParseResult<Limits> parse_limits(Stream& stream, u8 flag)
 {
-    ScopeLogger<WASM_BINPARSER_DEBUG> logger("Limits"sv);
-    auto flag = TRY_READ(stream, u8, ParseError::ExpectedKindTag);
-
-    if (flag > 1)
-        return with_eof_check(stream, ParseError::InvalidTag);
-
     auto min_or_error = stream.read_value<LEB128<u32>>();
     if (min_or_error.is_error())
         return with_eof_check(stream, ParseError::ExpectedSize);
@@ -170,11 +165,28 @@ ParseResult<Limits> Limits::parse(Stream& stream)
     return Limits { static_cast<u32>(min), move(max) };
 }
 
+ParseResult<Limits> Limits::parse(Stream& stream)
+{
+    ScopeLogger<WASM_BINPARSER_DEBUG> logger("Limits"sv);
+    auto flag = TRY_READ(stream, u8, ParseError::ExpectedKindTag);
+
+    if (flag > 1)
+        return with_eof_check(stream, ParseError::InvalidTag);
+
+    return parse_limits(stream, flag);
+}
+
 ParseResult<MemoryType> MemoryType::parse(Stream& stream)
 {
     ScopeLogger<WASM_BINPARSER_DEBUG> logger("MemoryType"sv);
-    auto limits_result = TRY(Limits::parse(stream));
-    return MemoryType { limits_result };
+    auto flag = TRY_READ(stream, u8, ParseError::ExpectedKindTag);
+
+    // Proposal "threads", bit 1 of the limits flag marks the memory as shared.
+    if (flag > 3)
+        return with_eof_check(stream, ParseError::InvalidTag);
+
+    auto limits_result = TRY(parse_limits(stream, flag & 1));
+    return MemoryType { limits_result, (flag & 2) != 0 };
 }
 
 ParseResult<TableType> TableType::parse(Stream& stream)
@@ -505,7 +517,8 @@ ParseResult<Instruction> Instruction::parse(Stream& stream)
     case Instructions::i64_extend32_s.value():
         return Instruction { opcode };
     case 0xfc:
-    case 0xfd: {
+    case 0xfd:
+    case 0xfe: {
         // These are multibyte instructions.
         auto selector = TRY_READ(stream, LEB128<u32>, ParseError::InvalidInput);
         OpCode full_opcode = static_cast<u64>(opcode.value()) << 56 | selector;
@@ -567,6 +580,72 @@ ParseResult<Instruction> Instruction::parse(Stream& stream)
             auto index = TRY(GenericIndexParser<TableIndex>::parse(stream));
             return Instruction { full_opcode, index };
         }
+        case Instructions::memory_atomic_notify.value():
+        case Instructions::memory_atomic_wait32.value():
+        case Instructions::memory_atomic_wait64.value():
+        case Instructions::i32_atomic_load.value():
+        case Instructions::i64_atomic_load.value():
+        case Instructions::i32_atomic_load8_u.value():
+        case Instructions::i32_atomic_load16_u.value():
+        case Instructions::i64_atomic_load8_u.value():
+        case Instructions::i64_atomic_load16_u.value():
+        case Instructions::i64_atomic_load32_u.value():
+        case Instructions::i32_atomic_store.value():
+        case Instructions::i64_atomic_store.value():
+        case Instructions::i32_atomic_store8.value():
+        case Instructions::i32_atomic_store16.value():
+        case Instructions::i64_atomic_store8.value():
+        case Instructions::i64_atomic_store16.value():
+        case Instructions::i64_atomic_store32.value():
+        case Instructions::i32_atomic_rmw_add.value():
+        case Instructions::i64_atomic_rmw_add.value():
+        case Instructions::i32_atomic_rmw8_add_u.value():
+        case Instructions::i32_atomic_rmw16_add_u.value():
+        case Instructions::i64_atomic_rmw8_add_u.value():
+        case Instructions::i64_atomic_rmw16_add_u.value():
+        case Instructions::i64_atomic_rmw32_add_u.value():
+        case Instructions::i32_atomic_rmw_sub.value():
+        case Instructions::i64_atomic_rmw_sub.value():
+        case Instructions::i32_atomic_rmw8_sub_u.value():
+        case Instructions::i32_atomic_rmw16_sub_u.value():
+        case Instructions::i64_atomic_rmw8_sub_u.value():
+        case Instructions::i64_atomic_rmw16_sub_u.value():
+        case Instructions::i64_atomic_rmw32_sub_u.value():
+        case Instructions::i32_atomic_rmw_and.value():
+        case Instructions::i64_atomic_rmw_and.value():
+        case Instructions::i32_atomic_rmw8_and_u.value():
+        case Instructions::i32_atomic_rmw16_and_u.value():
+        case Instructions::i64_atomic_rmw8_and_u.value():
+        case Instructions::i64_atomic_rmw16_and_u.value():
+        case Instructions::i64_atomic_rmw32_and_u.value():
+        case Instructions::i32_atomic_rmw_or.value():
+        case Instructions::i64_atomic_rmw_or.value():
+        case Instructions::i32_atomic_rmw8_or_u.value():
+        case Instructions::i32_atomic_rmw16_or_u.value():
+        case Instructions::i64_atomic_rmw8_or_u.value():
+        case Instructions::i64_atomic_rmw16_or_u.value():
+        case Instructions::i64_atomic_rmw32_or_u.value():
+        case Instructions::i32_atomic_rmw_xor.value():
+        case Instructions::i64_atomic_rmw_xor.value():
+        case Instructions::i32_atomic_rmw8_xor_u.value():
+        case Instructions::i32_atomic_rmw16_xor_u.value():
+        case Instructions::i64_atomic_rmw8_xor_u.value():
+        case Instructions::i64_atomic_rmw16_xor_u.value():
+        case Instructions::i64_atomic_rmw32_xor_u.value():
+        case Instructions::i32_atomic_rmw_xchg.value():
+        case Instructions::i64_atomic_rmw_xchg.value():
+        case Instructions::i32_atomic_rmw8_xchg_u.value():
+        case Instructions::i32_atomic_rmw16_xchg_u.value():
+        case Instructions::i64_atomic_rmw8_xchg_u.value():
+        case Instructions::i64_atomic_rmw16_xchg_u.value():
+        case Instructions::i64_atomic_rmw32_xchg_u.value():
+        case Instructions::i32_atomic_rmw_cmpxchg.value():
+        case Instructions::i64_atomic_rmw_cmpxchg.value():
+        case Instructions::i32_atomic_rmw8_cmpxchg_u.value():
+        case Instructions::i32_atomic_rmw16_cmpxchg_u.value():
+        case Instructions::i64_atomic_rmw8_cmpxchg_u.value():
+        case Instructions::i64_atomic_rmw16_cmpxchg_u.value():
+        case Instructions::i64_atomic_rmw32_cmpxchg_u.value():
         case Instructions::v128_load.value():
         case Instructions::v128_load8x8_s.value():
         case Instructions::v128_load8x8_u.value():
@@ -595,6 +674,13 @@ ParseResult<Instruction> Instruction::parse(Stream& stream)
 
             return Instruction { full_opcode, MemoryArgument { align, offset, MemoryIndex(memory_index) } };
         }
+        case Instructions::atomic_fence.value(): {
+            // Proposal "threads", a reserved zero byte follows the opcode.
+            auto reserved = TRY_READ(stream, u8, ParseError::InvalidInput);
+            if (reserved != 0)
+                return ParseError::InvalidImmediate;
+            return Instruction { full_opcode };
+        }
         case Instructions::v128_load8_lane.value():
         case Instructions::v128_load16_lane.value():
         case Instructions::v128_load32_lane.value():
@@ -960,6 +1046,91 @@ ParseResult<MemorySection> MemorySection::parse(Stream& stream)
     return MemorySection { memories };
 }
 
+static Expression::CompiledInstruction compile_instruction(Instruction const& instruction)
+{
+    using Kind = Expression::CompiledInstruction::Kind;
+
+    auto memory_access = [&](Kind kind) -> Expression::CompiledInstruction {
+        auto const& argument = instruction.arguments().get<Instruction::MemoryArgument>();
+        // The handlers only deal with the first memory, which is the only one most modules have.
+        if (argument.memory_index.value() != 0)
+            return {};
+        return { kind, argument.offset };
+    };
+
+    switch (instruction.opcode().value()) {
+    case Instructions::local_get.value():
+        return { Kind::local_get, instruction.arguments().get<LocalIndex>().value() };
+    case Instructions::local_set.value():
+        return { Kind::local_set, instruction.arguments().get<LocalIndex>().value() };
+    case Instructions::local_tee.value():
+        return { Kind::local_tee, instruction.arguments().get<LocalIndex>().value() };
+    case Instructions::i32_const.value():
+        return { Kind::i32_const, bit_cast<u32>(instruction.arguments().get<i32>()) };
+    case Instructions::i64_const.value():
+        return { Kind::i64_const, bit_cast<u64>(instruction.arguments().get<i64>()) };
+    case Instructions::br.value():
+        return { Kind::br, instruction.arguments().get<LabelIndex>().value() };
+    case Instructions::br_if.value():
+        return { Kind::br_if, instruction.arguments().get<LabelIndex>().value() };
+    case Instructions::i32_load.value():
+        return memory_access(Kind::i32_load);
+    case Instructions::i64_load.value():
+        return memory_access(Kind::i64_load);
+    case Instructions::f32_load.value():
+        return memory_access(Kind::f32_load);
+    case Instructions::f64_load.value():
+        return memory_access(Kind::f64_load);
+    case Instructions::i32_store.value():
+        return memory_access(Kind::i32_store);
+    case Instructions::i64_store.value():
+        return memory_access(Kind::i64_store);
+    case Instructions::f32_store.value():
+        return memory_access(Kind::f32_store);
+    case Instructions::f64_store.value():
+        return memory_access(Kind::f64_store);
+#define __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(name) \
+    case Instructions::name.value():                  \
+        return { Kind::name, 0 };
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(drop)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(structured_end)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_eqz)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_eq)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_ne)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_lts)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_ltu)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_gts)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_gtu)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_les)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_leu)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_ges)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_geu)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_add)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_sub)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_mul)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_and)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_or)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_xor)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_shl)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_shrs)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i32_shru)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i64_add)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i64_sub)
+        __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE(i64_mul)
+#undef __COMPILE_INSTRUCTION_WITHOUT_IMMEDIATE
+    default:
+        return {};
+    }
+}
+
+void Expression::compile()
+{
+    m_compiled_instructions.ensure_capacity(m_instructions.size() + 1);
+    for (auto const& instruction : m_instructions)
+        m_compiled_instructions.unchecked_append(compile_instruction(instruction));
+    m_compiled_instructions.unchecked_append({ CompiledInstruction::Kind::End, 0 });
+}
+
 ParseResult<Expression> Expression::parse(Stream& stream, Optional<size_t> size_hint)
 {
     ScopeLogger<WASM_BINPARSER_DEBUG> logger("Expression"sv);
@@ -1148,18 +1319,91 @@ ParseResult<CodeSection::Code> CodeSection::Code::parse(Stream& stream)
 {
     ScopeLogger<WASM_BINPARSER_DEBUG> logger("Code"sv);
     auto size = TRY_READ(stream, LEB128<u32>, ParseError::InvalidSize);
+    auto body_stream = ConstrainedStream { MaybeOwned<Stream>(stream), size };
 
     // Emprically, if there are `size` bytes to be read, then there's around
     // `size / 2` instructions, so we pass that as our size hint.
-    auto func = TRY(Func::parse(stream, size / 2));
+    auto func = TRY(Func::parse(body_stream, size / 2));
+    if (body_stream.remaining() != 0)
+        return ParseError::SectionSizeMismatch;
 
     return Code { size, move(func) };
 }
 
-ParseResult<CodeSection> CodeSection::parse(Stream& stream)
+ParseResult<CodeSection::Code> CodeSection::Code::parse(ReadonlyBytes body)
+{
+    ScopeLogger<WASM_BINPARSER_DEBUG> logger("Code"sv);
+    FixedMemoryStream stream { body };
+
+    auto func = TRY(Func::parse(stream, body.size() / 2));
+    if (!stream.is_eof())
+        return ParseError::SectionSizeMismatch;
+
+    return Code { static_cast<u32>(body.size()), move(func) };
+}
+
+ParseResult<CodeSection> CodeSection::parse(Stream& stream, size_t section_size)
 {
     ScopeLogger<WASM_BINPARSER_DEBUG> logger("CodeSection"sv);
-    auto result = TRY(parse_vector<Code>(stream));
+    if (section_size < minimum_code_size_for_parallel_compilation) {
+        auto result = TRY(parse_vector<Code>(stream));
+        return CodeSection { move(result) };
+    }
+
+    // Every function body is prefixed with its size, so read the whole section in one go, split it up into its bodies,
+    // then parse those independently.
+    auto section_or_error = ByteBuffer::create_uninitialized(section_size);
+    if (section_or_error.is_error())
+        return ParseError::OutOfMemory;
+    auto section = section_or_error.release_value();
+    if (stream.read_until_filled(section).is_error())
+        return with_eof_check(stream, ParseError::InvalidInput);
+
+    FixedMemoryStream section_stream { section.bytes() };
+    size_t count = TRY_READ(section_stream, LEB128<u32>, ParseError::ExpectedSize);
+    if (count > Constants::max_allowed_vector_size)
+        return ParseError::HugeAllocationRequested;
+
+    // A broken size prefix only stops us from finding the bodies after it; the ones before it still get parsed first,
+    // and their errors take precedence, just like when parsing them one after another.
+    Vector<ReadonlyBytes> bodies;
+    Optional<ParseError> framing_error;
+    for (size_t i = 0; i < count; ++i) {
+        auto size_or_error = section_stream.read_value<LEB128<u32>>();
+        if (size_or_error.is_error()) {
+            framing_error = with_eof_check(section_stream, ParseError::InvalidSize);
+            break;
+        }
+        size_t size = size_or_error.release_value();
+        if (size > section_stream.remaining()) {
+            framing_error = ParseError::UnexpectedEof;
+            break;
+        }
+        auto offset = MUST(section_stream.tell());
+        bodies.append(section.bytes().slice(offset, size));
+        MUST(section_stream.discard(size));
+    }
+    if (!framing_error.has_value() && !section_stream.is_eof())
+        framing_error = ParseError::SectionSizeMismatch;
+
+    auto body_count = bodies.size();
+    Vector<Optional<ParseResult<Code>>> functions;
+    functions.resize(body_count);
+    auto parse_body = [&](size_t index) {
+        functions[index] = Code::parse(bodies[index]);
+        return functions[index]->is_error() ? IterationDecision::Break : IterationDecision::Continue;
+    };
+    for_each_index_in_parallel(body_count, parse_body);
+
+    // Bodies are handed out in order, so we report the same error that parsing them one after another would have,
+    // and every body before the first failing one has been parsed. The one exception is a body that runs past the end
+    // of the section: we report UnexpectedEof for it without looking at its contents.
+    Vector<Code> result;
+    result.ensure_capacity(body_count);
+    for (auto& function : functions)
+        result.unchecked_append(TRY(function.release_value()));
+    if (framing_error.has_value())
+        return framing_error.release_value();
     return CodeSection { move(result) };
 }
 
@@ -1305,7 +1549,7 @@ ParseResult<NonnullRefPtr<Module>> Module::parse(Stream& stream)
             module.element_section() = TRY(ElementSection::parse(section_stream));
             break;
         case SectionId::SectionIdKind::Code:
-            module.code_section() = TRY(CodeSection::parse(section_stream));
+            module.code_section() = TRY(CodeSection::parse(section_stream, section_size));
             break;
         case SectionId::SectionIdKind::Data:
             module.data_section() = TRY(DataSection::parse(section_stream));
@@ -0,0 +1,108 @@
+// (module
+//   (memory 1 1 shared)
+//   (func (export "add") (param i32 i32) (result i32) (i32.atomic.rmw.add (local.get 0) (local.get 1)))
+//   (func (export "load") (param i32) (result i32) (i32.atomic.load (local.get 0)))
+//   (func (export "cmpxchg") (param i32 i32 i32) (result i32) (i32.atomic.rmw.cmpxchg (local.get 0) (local.get 1) (local.get 2)))
+//   (func (export "wait") (param i32 i32) (result i32) (memory.atomic.wait32 (local.get 0) (local.get 1) (i64.const 0)))
+//   (func (export "notify") (param i32 i32) (result i32) (memory.atomic.notify (local.get 0) (local.get 1))))
+// prettier-ignore
+const binary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x13, 0x03, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x60, 0x02, 0x7f, 0x7f, 0x01, 0x7f, 0x60, 0x03, 0x7f, 0x7f, 0x7f, 0x01, 0x7f, 0x03, 0x06, 0x05,
+    0x01, 0x00, 0x02, 0x01, 0x01, 0x05, 0x04, 0x01, 0x03, 0x01, 0x01, 0x07, 0x28, 0x05, 0x03, 0x61,
+    0x64, 0x64, 0x00, 0x00, 0x04, 0x6c, 0x6f, 0x61, 0x64, 0x00, 0x01, 0x07, 0x63, 0x6d, 0x70, 0x78,
+    0x63, 0x68, 0x67, 0x00, 0x02, 0x04, 0x77, 0x61, 0x69, 0x74, 0x00, 0x03, 0x06, 0x6e, 0x6f, 0x74,
+    0x69, 0x66, 0x79, 0x00, 0x04, 0x0a, 0x3a, 0x05, 0x0a, 0x00, 0x20, 0x00, 0x20, 0x01, 0xfe, 0x1e,
+    0x02, 0x00, 0x0b, 0x08, 0x00, 0x20, 0x00, 0xfe, 0x10, 0x02, 0x00, 0x0b, 0x0c, 0x00, 0x20, 0x00,
+    0x20, 0x01, 0x20, 0x02, 0xfe, 0x48, 0x02, 0x00, 0x0b, 0x0c, 0x00, 0x20, 0x00, 0x20, 0x01, 0x42,
+    0x00, 0xfe, 0x01, 0x02, 0x00, 0x0b, 0x0a, 0x00, 0x20, 0x00, 0x20, 0x01, 0xfe, 0x00, 0x02, 0x00,
+    0x0b,
+]);
+
+test("read-modify-write returns the previous value", () => {
+    const module = parseWebAssemblyModule(binary);
+    const add = module.getExport("add");
+    const load = module.getExport("load");
+    expect(module.invoke(add, 8, 5)).toBe(0);
+    expect(module.invoke(add, 8, 2)).toBe(5);
+    expect(module.invoke(load, 8)).toBe(7);
+});
+
+test("compare-exchange only stores on a match", () => {
+    const module = parseWebAssemblyModule(binary);
+    const cmpxchg = module.getExport("cmpxchg");
+    const load = module.getExport("load");
+    expect(module.invoke(cmpxchg, 16, 1, 9)).toBe(0);
+    expect(module.invoke(load, 16)).toBe(0);
+    expect(module.invoke(cmpxchg, 16, 0, 9)).toBe(0);
+    expect(module.invoke(load, 16)).toBe(9);
+});
+
+test("wait and notify", () => {
+    const module = parseWebAssemblyModule(binary);
+    const wait = module.getExport("wait");
+    const notify = module.getExport("notify");
+    // "not-equal"
+    expect(module.invoke(wait, 24, 1)).toBe(1);
+    // "timed-out"
+    expect(module.invoke(wait, 24, 0)).toBe(2);
+    expect(module.invoke(notify, 24, 1)).toBe(0);
+});
+
+test("unaligned accesses trap", () => {
+    const module = parseWebAssemblyModule(binary);
+    const load = module.getExport("load");
+    expect(() => module.invoke(load, 2)).toThrowWithMessage(
+        TypeError,
+        "Execution trapped: Unaligned atomic memory access"
+    );
+});
+
+// (module
+//   (memory 1 1 shared)
+//   (func (export "wait") (param i32 i32 i64) (result i32) (memory.atomic.wait32 (local.get 0) (local.get 1) (local.get 2))))
+// prettier-ignore
+const waitBinary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x08, 0x01, 0x60, 0x03, 0x7f, 0x7f, 0x7e,
+    0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x05, 0x04, 0x01, 0x03, 0x01, 0x01, 0x07, 0x08, 0x01, 0x04,
+    0x77, 0x61, 0x69, 0x74, 0x00, 0x00, 0x0a, 0x0e, 0x01, 0x0c, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20,
+    0x02, 0xfe, 0x01, 0x02, 0x00, 0x0b,
+]);
+
+test("waits that would block trap", () => {
+    const module = parseWebAssemblyModule(waitBinary);
+    const wait = module.getExport("wait");
+    // "not-equal" and "timed-out" don't need to block.
+    expect(module.invoke(wait, 0, 1, 1000n)).toBe(1);
+    expect(module.invoke(wait, 0, 0, 0n)).toBe(2);
+    expect(() => module.invoke(wait, 0, 0, 1000n)).toThrowWithMessage(
+        TypeError,
+        "Execution trapped: Waiting on a memory that no other agent can notify"
+    );
+    expect(() => module.invoke(wait, 0, 0, -1n)).toThrowWithMessage(
+        TypeError,
+        "Execution trapped: Waiting on a memory that no other agent can notify"
+    );
+});
+
+// (module (memory (export "mem") 1 1))
+// prettier-ignore
+const unsharedMemoryBinary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x05, 0x04, 0x01, 0x01, 0x01, 0x01, 0x07, 0x07,
+    0x01, 0x03, 0x6d, 0x65, 0x6d, 0x02, 0x00,
+]);
+
+// (module (import "a" "mem" (memory 1 1 shared)))
+// prettier-ignore
+const sharedMemoryImportBinary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x02, 0x0b, 0x01, 0x01, 0x61, 0x03, 0x6d, 0x65,
+    0x6d, 0x02, 0x03, 0x01, 0x01,
+]);
+
+test("memory imports must match in sharedness", () => {
+    const a = parseWebAssemblyModule(unsharedMemoryBinary);
+    expect(() => parseWebAssemblyModule(sharedMemoryImportBinary, { a })).toThrowWithMessage(
+        TypeError,
+        "a::mem: Memory import and extern do not match: shared vs unshared"
+    );
+});
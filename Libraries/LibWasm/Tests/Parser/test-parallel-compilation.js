@@ -0,0 +1,80 @@
+// Code sections of at least 256 KiB are parsed and validated on multiple threads.
+// These modules are well above that, so they take the parallel path.
+const functionCount = 400;
+const paddingSize = 1024;
+
+function leb128(value) {
+    const bytes = [];
+    do {
+        let byte = value & 0x7f;
+        value >>>= 7;
+        if (value !== 0) byte |= 0x80;
+        bytes.push(byte);
+    } while (value !== 0);
+    return bytes;
+}
+
+function section(id, contents) {
+    return [id, ...leb128(contents.length), ...contents];
+}
+
+// Every function is `(func (result i32) nop* i32.const 42)`, unless `bodies` has a replacement for its index.
+// The last function is exported as "last".
+function buildModule(bodies = {}) {
+    const validBody = [0x00, ...new Array(paddingSize).fill(0x01), 0x41, 0x2a, 0x0b];
+
+    const code = [...leb128(functionCount)];
+    for (let i = 0; i < functionCount; ++i) {
+        const body = bodies[i] ?? validBody;
+        code.push(...leb128(body.length), ...body);
+    }
+
+    // prettier-ignore
+    return new Uint8Array([
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+        ...section(0x01, [0x01, 0x60, 0x00, 0x01, 0x7f]),
+        ...section(0x03, [...leb128(functionCount), ...new Array(functionCount).fill(0x00)]),
+        ...section(0x07, [0x01, 0x04, 0x6c, 0x61, 0x73, 0x74, 0x00, ...leb128(functionCount - 1)]),
+        ...section(0x0a, code),
+    ]);
+}
+
+// (func (result i32) local.get 0), without any locals.
+const invalidLocalBody = [0x00, 0x20, 0x00, 0x0b];
+// (func (result i32) global.get 0), without any globals.
+const invalidGlobalBody = [0x00, 0x23, 0x00, 0x0b];
+// A valid body, followed by bytes that are still within its declared size.
+const oversizedBody = [0x00, 0x41, 0x2a, 0x0b, 0x01, 0x01];
+// An opcode that doesn't exist.
+const unknownInstructionBody = [0x00, 0xff, 0x0b];
+
+test("large modules are parsed and validated", () => {
+    const module = parseWebAssemblyModule(buildModule());
+    expect(module.invoke(module.getExport("last"))).toBe(42);
+});
+
+describe("the first invalid function body is the one reported", () => {
+    test("validation", () => {
+        expect(() =>
+            parseWebAssemblyModule(buildModule({ 10: invalidLocalBody, 390: invalidGlobalBody }))
+        ).toThrowWithMessage(TypeError, "Invalid LocalIndex");
+        expect(() =>
+            parseWebAssemblyModule(buildModule({ 10: invalidGlobalBody, 390: invalidLocalBody }))
+        ).toThrowWithMessage(TypeError, "Invalid GlobalIndex");
+    });
+
+    test("parsing", () => {
+        expect(() =>
+            parseWebAssemblyModule(buildModule({ 10: oversizedBody, 390: unknownInstructionBody }))
+        ).toThrowWithMessage(SyntaxError, "A parsed section did not fulfill its expected size");
+        expect(() =>
+            parseWebAssemblyModule(buildModule({ 10: unknownInstructionBody, 390: oversizedBody }))
+        ).toThrowWithMessage(SyntaxError, "A parsed instruction was not known to this parser");
+    });
+
+    test("parse errors win over validation errors", () => {
+        expect(() =>
+            parseWebAssemblyModule(buildModule({ 10: invalidLocalBody, 390: unknownInstructionBody }))
+        ).toThrowWithMessage(SyntaxError, "A parsed instruction was not known to this parser");
+    });
+});
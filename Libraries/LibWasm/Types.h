@@ -269,17 +269,22 @@ private:
 // https://webassembly.github.io/spec/core/bikeshed/#memory-types%E2%91%A4
 class MemoryType {
 public:
-    explicit MemoryType(Limits limits)
+    explicit MemoryType(Limits limits, bool is_shared = false)
         : m_limits(move(limits))
+        , m_is_shared(is_shared)
     {
     }
 
     auto& limits() const { return m_limits; }
 
+    // Proposal "threads", shared memories may be accessed by multiple agents at once.
+    bool is_shared() const { return m_is_shared; }
+
     static ParseResult<MemoryType> parse(Stream& stream);
 
 private:
     Limits m_limits;
+    bool m_is_shared { false };
 };
 
 // https://webassembly.github.io/spec/core/bikeshed/#table-types%E2%91%A4
@@ -697,19 +702,93 @@ private:
     Vector<Memory> m_memories;
 };
 
+// Instructions that have a dedicated handler in the interpreter's threaded dispatch loop.
+#define ENUMERATE_WASM_COMPILED_INSTRUCTIONS(M) \
+    M(local_get)                                \
+    M(local_set)                                \
+    M(local_tee)                                \
+    M(i32_const)                                \
+    M(i64_const)                                \
+    M(drop)                                     \
+    M(br)                                       \
+    M(br_if)                                    \
+    M(structured_end)                           \
+    M(i32_load)                                 \
+    M(i64_load)                                 \
+    M(f32_load)                                 \
+    M(f64_load)                                 \
+    M(i32_store)                                \
+    M(i64_store)                                \
+    M(f32_store)                                \
+    M(f64_store)                                \
+    M(i32_eqz)                                  \
+    M(i32_eq)                                   \
+    M(i32_ne)                                   \
+    M(i32_lts)                                  \
+    M(i32_ltu)                                  \
+    M(i32_gts)                                  \
+    M(i32_gtu)                                  \
+    M(i32_les)                                  \
+    M(i32_leu)                                  \
+    M(i32_ges)                                  \
+    M(i32_geu)                                  \
+    M(i32_add)                                  \
+    M(i32_sub)                                  \
+    M(i32_mul)                                  \
+    M(i32_and)                                  \
+    M(i32_or)                                   \
+    M(i32_xor)                                  \
+    M(i32_shl)                                  \
+    M(i32_shrs)                                 \
+    M(i32_shru)                                 \
+    M(i64_add)                                  \
+    M(i64_sub)                                  \
+    M(i64_mul)
+
 class Expression {
 public:
+    // A pre-decoded instruction, with its immediate operand stored inline.
+    // Instructions without a dedicated handler are `Generic`, and are executed from the original Instruction.
+    struct CompiledInstruction {
+        enum class Kind : u8 {
+            Generic,
+#define __ENUMERATE_COMPILED_INSTRUCTION(name) name,
+            ENUMERATE_WASM_COMPILED_INSTRUCTIONS(__ENUMERATE_COMPILED_INSTRUCTION)
+#undef __ENUMERATE_COMPILED_INSTRUCTION
+            // Placed after the last instruction, so the dispatch loop doesn't have to check for the end itself.
+            End,
+        };
+
+        Kind kind { Kind::Generic };
+        u64 immediate { 0 };
+    };
+
     explicit Expression(Vector<Instruction> instructions)
         : m_instructions(move(instructions))
     {
+        compile();
     }
 
     auto& instructions() const { return m_instructions; }
+    auto& compiled_instructions() const { return m_compiled_instructions; }
+
+    // The most values and labels this expression ever has on the stack at once, as determined by validation.
+    // These let the interpreter reserve all the stack space an invocation needs up front.
+    struct StackUsage {
+        size_t values { 0 };
+        size_t labels { 0 };
+    };
+    void set_stack_usage_hint(StackUsage usage) { m_stack_usage_hint = usage; }
+    auto const& stack_usage_hint() const { return m_stack_usage_hint; }
 
     static ParseResult<Expression> parse(Stream& stream, Optional<size_t> size_hint = {});
 
 private:
+    void compile();
+
     Vector<Instruction> m_instructions;
+    Vector<CompiledInstruction> m_compiled_instructions;
+    Optional<StackUsage> m_stack_usage_hint;
 };
 
 class GlobalSection {
@@ -880,16 +959,23 @@ public:
             : m_locals(move(locals))
             , m_body(move(body))
         {
+            for (auto const& local : m_locals)
+                m_total_local_count += local.n();
         }
 
         auto& locals() const { return m_locals; }
+        auto& body() { return m_body; }
         auto& body() const { return m_body; }
 
+        // The number of declared locals, not counting parameters.
+        auto total_local_count() const { return m_total_local_count; }
+
         static ParseResult<Func> parse(Stream& stream, size_t size_hint);
 
     private:
         Vector<Locals> m_locals;
         Expression m_body;
+        u64 m_total_local_count { 0 };
     };
     class Code {
     public:
@@ -900,9 +986,11 @@ public:
         }
 
         auto size() const { return m_size; }
+        auto& func() { return m_func; }
         auto& func() const { return m_func; }
 
         static ParseResult<Code> parse(Stream& stream);
+        static ParseResult<Code> parse(ReadonlyBytes body);
 
     private:
         u32 m_size { 0 };
@@ -916,9 +1004,10 @@ public:
     {
     }
 
+    auto& functions() { return m_functions; }
     auto& functions() const { return m_functions; }
 
-    static ParseResult<CodeSection> parse(Stream& stream);
+    static ParseResult<CodeSection> parse(Stream& stream, size_t section_size);
 
 private:
     Vector<Code> m_functions;
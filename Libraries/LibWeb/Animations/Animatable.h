@@ -64,6 +64,9 @@ public:
     GC::Ptr<CSS::CSSTransition> property_transition(CSS::PropertyID) const;
     void clear_transitions();
 
+    // Whether any animation, transition or cached CSS animation state has ever been attached to this.
+    bool has_animation_state() const { return !!m_impl; }
+
 protected:
     void visit_edges(JS::Cell::Visitor&);
 
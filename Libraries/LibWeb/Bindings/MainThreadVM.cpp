@@ -11,6 +11,7 @@
 #include <LibGC/DeferGC.h>
 #include <LibJS/AST.h>
 #include <LibJS/Module.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/Environment.h>
 #include <LibJS/Runtime/FinalizationRegistry.h>
@@ -100,6 +101,9 @@ void initialize_main_thread_vm(AgentType type)
         dbgln("FIXME: Unimplemented IDL interface: '{}.{}'", object.class_name(), property_key.to_string());
     };
 
+    // Navigations within this process tend to load the same scripts over and over, so let's not reparse them every time.
+    s_main_thread_vm->program_cache().set_capacity_in_bytes(64 * MiB);
+
     // NOTE: We intentionally leak the main thread JavaScript VM.
     //       This avoids doing an exhaustive garbage collection on process exit.
     s_main_thread_vm->ref();
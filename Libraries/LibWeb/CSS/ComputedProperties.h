@@ -240,6 +240,9 @@ public:
         m_attempted_pseudo_class_matches = results;
     }
 
+    // Returns a copy of everything but the animated values, for handing to another element that computes to the same style.
+    [[nodiscard]] GC::Ref<ComputedProperties> clone_without_animated_values(GC::Heap&) const;
+
 private:
     friend class StyleComputer;
 
@@ -77,6 +77,33 @@ static bool can_selector_use_fast_matches(CSS::Selector const& selector)
     return true;
 }
 
+// Type, class and ID selectors joined by descendant and child combinators only read DOM state that can't change while
+// style is being computed, and never write anything back, so they can be matched on several threads at once.
+static bool can_selector_be_matched_in_parallel(CSS::Selector const& selector)
+{
+    if (!selector.can_use_fast_matches())
+        return false;
+
+    for (auto const& compound_selector : selector.compound_selectors()) {
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            switch (simple_selector.type) {
+            case CSS::Selector::SimpleSelector::Type::Class:
+            case CSS::Selector::SimpleSelector::Type::Id:
+                break;
+            case CSS::Selector::SimpleSelector::Type::TagName:
+            case CSS::Selector::SimpleSelector::Type::Universal:
+                // Looking up a namespace prefix copies the namespace string.
+                if (simple_selector.qualified_name().namespace_type == CSS::Selector::SimpleSelector::QualifiedName::NamespaceType::Named)
+                    return false;
+                break;
+            default:
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
     : m_compound_selectors(move(compound_selectors))
 {
@@ -130,6 +157,7 @@ Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
     collect_ancestor_hashes();
 
     m_can_use_fast_matches = can_selector_use_fast_matches(*this);
+    m_can_be_matched_in_parallel = can_selector_be_matched_in_parallel(*this);
 }
 
 void Selector::collect_ancestor_hashes()
@@ -247,6 +247,7 @@ public:
 
     bool can_use_fast_matches() const { return m_can_use_fast_matches; }
     bool can_use_ancestor_filter() const { return m_can_use_ancestor_filter; }
+    bool can_be_matched_in_parallel() const { return m_can_be_matched_in_parallel; }
 
     size_t sibling_invalidation_distance() const;
 
@@ -259,6 +260,7 @@ private:
     mutable Optional<size_t> m_sibling_invalidation_distance;
     bool m_can_use_fast_matches { false };
     bool m_can_use_ancestor_filter { false };
+    bool m_can_be_matched_in_parallel { false };
     bool m_contains_the_nesting_selector { false };
 
     PseudoClassBitmap m_contained_pseudo_classes;
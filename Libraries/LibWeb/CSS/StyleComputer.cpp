@@ -7,6 +7,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/BinarySearch.h>
 #include <AK/Debug.h>
 #include <AK/Error.h>
@@ -17,6 +18,7 @@
 #include <AK/NonnullRawPtr.h>
 #include <AK/QuickSort.h>
 #include <AK/TemporaryChange.h>
+#include <LibCore/System.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Font/FontStyleMapping.h>
@@ -24,6 +26,7 @@
 #include <LibGfx/Font/Typeface.h>
 #include <LibGfx/Font/WOFF/Loader.h>
 #include <LibGfx/Font/WOFF2/Loader.h>
+#include <LibThreading/Thread.h>
 #include <LibWeb/Animations/AnimationEffect.h>
 #include <LibWeb/Animations/DocumentTimeline.h>
 #include <LibWeb/Bindings/PrincipalHostDefined.h>
@@ -74,6 +77,7 @@
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/NamedNodeMap.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/Fetch/Infrastructure/FetchController.h>
 #include <LibWeb/Fetch/Response.h>
@@ -489,6 +493,12 @@ bool StyleComputer::invalidation_property_used_in_has_selector(InvalidationSet::
     return false;
 }
 
+// Rules whose sheet declares a default namespace compare namespaces by value, so those are always matched on the main thread.
+static bool can_match_rule_in_parallel(MatchingRule const& rule)
+{
+    return rule.selector.can_be_matched_in_parallel() && !(rule.sheet && rule.sheet->default_namespace_rule());
+}
+
 Vector<MatchingRule const*> StyleComputer::collect_matching_rules(DOM::Element const& element, CascadeOrigin cascade_origin, Optional<CSS::PseudoElement> pseudo_element, PseudoClassBitmap& attempted_pseudo_class_matches, FlyString const& qualified_layer_name) const
 {
     auto const& root_node = element.root();
@@ -502,6 +512,13 @@ Vector<MatchingRule const*> StyleComputer::collect_matching_rules(DOM::Element c
     else if (shadow_root)
         shadow_host = shadow_root->host();
 
+    // Rules that were already matched against this element on a worker thread only need to be looked up.
+    Vector<MatchingRule const*> const* parallel_matches = nullptr;
+    if (!pseudo_element.has_value() && !m_parallel_selector_matches.is_empty()) {
+        if (auto it = m_parallel_selector_matches.find(&element); it != m_parallel_selector_matches.end())
+            parallel_matches = &it->value;
+    }
+
     Vector<MatchingRule const&, 512> rules_to_run;
 
     auto add_rule_to_run = [&](MatchingRule const& rule_to_run) {
@@ -568,6 +585,13 @@ Vector<MatchingRule const*> StyleComputer::collect_matching_rules(DOM::Element c
     matching_rules.ensure_capacity(rules_to_run.size());
 
     for (auto const& rule_to_run : rules_to_run) {
+        if (parallel_matches && can_match_rule_in_parallel(rule_to_run)) {
+            MatchingRule const* rule = &rule_to_run;
+            if (binary_search(*parallel_matches, rule))
+                matching_rules.append(rule);
+            continue;
+        }
+
         // NOTE: When matching an element against a rule from outside the shadow root's style scope,
         //       we have to pass in null for the shadow host, otherwise combinator traversal will
         //       be confined to the element itself (since it refuses to cross the shadow boundary).
@@ -2434,6 +2458,216 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_pseudo_element_style_if_neede
     return compute_style_impl(element, move(pseudo_element), ComputeStyleMode::CreatePseudoElementStyleIfNeeded);
 }
 
+static constexpr size_t minimum_element_count_for_parallel_selector_matching = 4096;
+static constexpr size_t elements_per_parallel_selector_matching_batch = 128;
+static constexpr size_t max_parallel_selector_matching_threads = 16;
+
+void StyleComputer::match_selectors_in_parallel(Badge<DOM::Document>, ReadonlySpan<GC::Ref<DOM::Element>> elements)
+{
+    if (elements.size() < minimum_element_count_for_parallel_selector_matching)
+        return;
+    auto thread_count = min(static_cast<size_t>(Core::System::hardware_concurrency()), max_parallel_selector_matching_threads);
+    if (thread_count < 2)
+        return;
+
+    build_rule_cache_if_needed();
+
+    // These are exactly the rule caches collect_matching_rules() will look at for an element outside of shadow trees.
+    Vector<RuleCache const*> rule_caches;
+    auto add_rule_cache = [&](CascadeOrigin cascade_origin, FlyString const& qualified_layer_name) {
+        if (auto const* rule_cache = rule_cache_for_cascade_origin(cascade_origin, qualified_layer_name, nullptr))
+            rule_caches.append(rule_cache);
+    };
+    add_rule_cache(CascadeOrigin::UserAgent, {});
+    add_rule_cache(CascadeOrigin::User, {});
+    for (auto const& layer_name : m_qualified_layer_names_in_order)
+        add_rule_cache(CascadeOrigin::Author, layer_name);
+    add_rule_cache(CascadeOrigin::Author, {});
+
+    Vector<Vector<MatchingRule const*>> matches_per_element;
+    matches_per_element.resize(elements.size());
+
+    // NOTE: The main thread is blocked until all workers are done, so nothing can change the DOM or the rule caches
+    //       under them. Workers only write to the entries for their own elements, and never touch the GC heap.
+    auto match_element = [&](size_t index) {
+        auto const& element = *elements[index];
+        auto& matches = matches_per_element[index];
+        for (auto const* rule_cache : rule_caches) {
+            rule_cache->for_each_matching_rules(element, {}, [&](Vector<MatchingRule> const& rules) {
+                for (auto const& rule : rules) {
+                    if (rule.contains_pseudo_element || !can_match_rule_in_parallel(rule))
+                        continue;
+                    SelectorEngine::MatchContext context {
+                        .style_sheet_for_rule = rule.sheet,
+                        .subject = element,
+                    };
+                    if (SelectorEngine::matches(rule.selector, element, nullptr, context))
+                        matches.append(&rule);
+                }
+                return IterationDecision::Continue;
+            });
+        }
+        quick_sort(matches);
+    };
+
+    auto batch_count = ceil_div(elements.size(), elements_per_parallel_selector_matching_batch);
+    Atomic<size_t> next_batch { 0 };
+    auto run_batches = [&] {
+        for (;;) {
+            auto batch = next_batch.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+            if (batch >= batch_count)
+                return;
+            auto end = min((batch + 1) * elements_per_parallel_selector_matching_batch, elements.size());
+            for (auto index = batch * elements_per_parallel_selector_matching_batch; index < end; ++index)
+                match_element(index);
+        }
+    };
+
+    Vector<NonnullRefPtr<Threading::Thread>> workers;
+    for (size_t i = 1; i < thread_count; ++i) {
+        auto worker_or_error = Threading::Thread::try_create([&]() -> intptr_t {
+            run_batches();
+            return 0;
+        },
+            "Style matcher"sv);
+        // Not being able to spawn a worker is fine, the remaining threads will just pick up its share.
+        if (worker_or_error.is_error())
+            break;
+        auto worker = worker_or_error.release_value();
+        worker->start();
+        workers.append(move(worker));
+    }
+
+    run_batches();
+
+    for (auto& worker : workers)
+        (void)worker->join();
+
+    m_parallel_selector_matches.ensure_capacity(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i)
+        m_parallel_selector_matches.set(elements[i].ptr(), move(matches_per_element[i]));
+}
+
+// Whether the style of this element is fully determined by its tag, its attributes and its ancestors, making it
+// possible to share it with a sibling that has the same tag and attributes.
+static bool is_eligible_for_style_sharing(DOM::Element& element)
+{
+    if (element.inline_style() || element.is_document_element() || element.is_shadow_host() || element.rendered_in_top_layer())
+        return false;
+
+    // Animations and transitions write into the computed style of the element they belong to.
+    if (element.has_animation_state())
+        return false;
+
+    auto parent = element.parent_element();
+    return parent && !parent->is_shadow_host() && parent->computed_properties();
+}
+
+// Whether the rules that matched this element may have depended on more than its tag, attributes and ancestors.
+static bool style_depends_on_element_state(DOM::Element const& element, ComputedProperties const& style)
+{
+    if (element.style_affected_by_structural_changes()
+        || element.affected_by_has_pseudo_class_in_subject_position()
+        || element.affected_by_has_pseudo_class_in_non_subject_position()
+        || element.affected_by_has_pseudo_class_with_relative_selector_that_has_sibling_combinator())
+        return true;
+
+    if (style.animation_name_source() || style.transition_property_source())
+        return true;
+
+    for (size_t i = 0; i < to_underlying(PseudoClass::__Count); ++i) {
+        auto pseudo_class = static_cast<PseudoClass>(i);
+        if (!style.has_attempted_match_against_pseudo_class(pseudo_class))
+            continue;
+        switch (pseudo_class) {
+        case PseudoClass::AnyLink:
+        case PseudoClass::Defined:
+        case PseudoClass::Is:
+        case PseudoClass::Lang:
+        case PseudoClass::Link:
+        case PseudoClass::Not:
+        case PseudoClass::Where:
+            continue;
+        default:
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool have_same_attributes(DOM::Element const& a, DOM::Element const& b)
+{
+    if (a.attribute_list_size() != b.attribute_list_size())
+        return false;
+    if (a.attribute_list_size() == 0)
+        return true;
+
+    auto const& a_attributes = *a.attributes();
+    auto const& b_attributes = *b.attributes();
+    for (u32 i = 0; i < a_attributes.length(); ++i) {
+        auto const* a_attribute = a_attributes.item(i);
+        auto const* b_attribute = b_attributes.item(i);
+        if (a_attribute->local_name() != b_attribute->local_name()
+            || a_attribute->namespace_uri() != b_attribute->namespace_uri()
+            || a_attribute->value() != b_attribute->value())
+            return false;
+    }
+    return true;
+}
+
+void StyleComputer::disable_style_sharing(Badge<DOM::Document>)
+{
+    m_style_sharing_enabled = false;
+    m_style_sharing_candidates.clear();
+    m_next_style_sharing_candidate = 0;
+}
+
+GC::Ptr<ComputedProperties> StyleComputer::share_style_with_sibling_if_possible(DOM::Element& element) const
+{
+    if (!m_style_sharing_enabled || m_style_sharing_candidates.is_empty() || !is_eligible_for_style_sharing(element))
+        return {};
+
+    auto parent_style = element.parent_element()->computed_properties();
+    for (auto const& candidate : m_style_sharing_candidates) {
+        auto& candidate_element = *candidate.element;
+        if (candidate_element.parent() != element.parent() || candidate.parent_style.ptr() != parent_style.ptr())
+            continue;
+        if (candidate_element.local_name() != element.local_name()
+            || candidate_element.namespace_uri() != element.namespace_uri()
+            || candidate_element.is_value() != element.is_value()
+            || candidate_element.custom_element_state() != element.custom_element_state())
+            continue;
+        if (!have_same_attributes(candidate_element, element))
+            continue;
+
+        // The rules and the cascade would produce exactly what they produced for the candidate, so adopt its results.
+        element.set_cascaded_properties({}, candidate_element.cascaded_properties({}));
+        element.set_custom_properties({}, candidate_element.custom_properties({}));
+        if (candidate_element.style_uses_css_custom_properties())
+            element.set_style_uses_css_custom_properties(true);
+        return candidate.style->clone_without_animated_values(document().heap());
+    }
+    return {};
+}
+
+void StyleComputer::add_style_sharing_candidate(DOM::Element& element, ComputedProperties& style) const
+{
+    if (!m_style_sharing_enabled || !is_eligible_for_style_sharing(element) || style_depends_on_element_state(element, style))
+        return;
+
+    StyleSharingCandidate candidate {
+        .element = element,
+        .parent_style = element.parent_element()->computed_properties(),
+        .style = style,
+    };
+    if (m_style_sharing_candidates.size() < style_sharing_cache_size) {
+        m_style_sharing_candidates.append(move(candidate));
+        return;
+    }
+    m_style_sharing_candidates[m_next_style_sharing_candidate] = move(candidate);
+    m_next_style_sharing_candidate = (m_next_style_sharing_candidate + 1) % style_sharing_cache_size;
+}
+
 GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::Element& element, Optional<CSS::PseudoElement> pseudo_element, ComputeStyleMode mode) const
 {
     build_rule_cache_if_needed();
@@ -2453,6 +2687,12 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::Element& elem
 
     ScopeGuard guard { [&element]() { element.set_needs_style_update(false); } };
 
+    bool may_share_style = mode == ComputeStyleMode::Normal && !pseudo_element.has_value();
+    if (may_share_style) {
+        if (auto style = share_style_with_sibling_if_possible(element))
+            return style;
+    }
+
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
     PseudoClassBitmap attempted_pseudo_class_matches;
@@ -2491,6 +2731,8 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::Element& elem
 
     auto computed_properties = compute_properties(element, pseudo_element, cascaded_properties);
     computed_properties->set_attempted_pseudo_class_matches(attempted_pseudo_class_matches);
+    if (may_share_style)
+        add_style_sharing_candidate(element, computed_properties);
     return computed_properties;
 }
 
@@ -3028,6 +3270,10 @@ void StyleComputer::invalidate_rule_cache()
 
     m_pseudo_class_rule_cache = {};
     m_style_invalidation_data = nullptr;
+
+    m_style_sharing_candidates.clear();
+    m_next_style_sharing_candidate = 0;
+    m_parallel_selector_matches.clear();
 }
 
 void StyleComputer::did_load_font(FlyString const&)
@@ -3284,7 +3530,9 @@ void RuleCache::for_each_matching_rules(DOM::Element const& element, Optional<Ps
                 return;
         }
     }
-    if (auto id = element.id(); id.has_value()) {
+    // NOTE: This may run on several threads at once (see StyleComputer::match_selectors_in_parallel()), so don't copy any
+    //       of the element's strings here, as that would touch their reference counts.
+    if (auto const& id = element.id(); id.has_value()) {
         if (auto it = rules_by_id.find(id.value()); it != rules_by_id.end()) {
             if (callback(it->value) == IterationDecision::Break)
                 return;
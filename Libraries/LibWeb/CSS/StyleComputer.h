@@ -187,6 +187,17 @@ public:
 
     void set_viewport_rect(Badge<DOM::Document>, CSSPixelRect const& viewport_rect) { m_viewport_rect = viewport_rect; }
 
+    // Siblings may only share computed style while a style update is in progress, as nothing can change the DOM or
+    // the style sheets during that time.
+    void enable_style_sharing(Badge<DOM::Document>) { m_style_sharing_enabled = true; }
+    void disable_style_sharing(Badge<DOM::Document>);
+
+    // Matches the selectors that are safe to evaluate off the main thread against all of the given elements at once,
+    // spread over a few worker threads. Until the results are discarded, collect_matching_rules() looks them up instead.
+    // Only worth it (and only done) for large style updates.
+    void match_selectors_in_parallel(Badge<DOM::Document>, ReadonlySpan<GC::Ref<DOM::Element>>);
+    void discard_parallel_selector_matches(Badge<DOM::Document>) { m_parallel_selector_matches.clear(); }
+
     enum class AnimationRefresh {
         No,
         Yes,
@@ -215,6 +226,8 @@ private:
 
     [[nodiscard]] GC::Ptr<ComputedProperties> compute_style_impl(DOM::Element&, Optional<CSS::PseudoElement>, ComputeStyleMode) const;
     [[nodiscard]] GC::Ref<CascadedProperties> compute_cascaded_values(DOM::Element&, Optional<CSS::PseudoElement>, bool& did_match_any_pseudo_element_rules, PseudoClassBitmap& attempted_pseudo_class_matches, ComputeStyleMode) const;
+    [[nodiscard]] GC::Ptr<ComputedProperties> share_style_with_sibling_if_possible(DOM::Element&) const;
+    void add_style_sharing_candidate(DOM::Element&, ComputedProperties&) const;
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_ascending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_descending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
     RefPtr<Gfx::FontCascadeList const> font_matching_algorithm(FlyString const& family_name, int weight, int slope, float font_size_in_pt) const;
@@ -310,6 +323,20 @@ private:
 
     CSSPixelRect m_viewport_rect;
 
+    // Recently styled elements whose computed style may be reused by their siblings.
+    struct StyleSharingCandidate {
+        GC::Root<DOM::Element> element;
+        GC::Root<ComputedProperties> parent_style;
+        GC::Root<ComputedProperties> style;
+    };
+    static constexpr size_t style_sharing_cache_size = 8;
+    bool m_style_sharing_enabled { false };
+    mutable Vector<StyleSharingCandidate, style_sharing_cache_size> m_style_sharing_candidates;
+    mutable size_t m_next_style_sharing_candidate { 0 };
+
+    // The rules with selectors safe to match in parallel that matched each element, sorted by address.
+    HashMap<DOM::Element const*, Vector<MatchingRule const*>> m_parallel_selector_matches;
+
     CountingBloomFilter<u8, 14> m_ancestor_filter;
 };
 
@@ -1284,6 +1284,142 @@ static void propagate_overflow_to_viewport(Element& root_element, Layout::Viewpo
     overflow_origin_computed_values.set_overflow_y(CSS::Overflow::Visible);
 }
 
+static void prepare_subtree_for_layout(Layout::Box& root, Layout::Viewport& viewport)
+{
+    root.for_each_in_inclusive_subtree_of_type<Layout::Box>([&](auto& child) {
+        if (auto dom_node = child.dom_node(); dom_node && dom_node->is_element()) {
+            child.set_has_size_containment(as<Element>(*dom_node).has_size_containment());
+        }
+        if (child.needs_layout_update()) {
+            child.reset_cached_intrinsic_sizes();
+        }
+        child.clear_contained_abspos_children();
+        return TraversalDecision::Continue;
+    });
+
+    // Assign each box that establishes a formatting context a list of absolutely positioned children it should take care of during layout
+    root.for_each_in_subtree_of_type<Layout::Box>([&](auto& child) {
+        if (!child.is_absolutely_positioned())
+            return TraversalDecision::Continue;
+        if (auto containing_block = child.containing_block()) {
+            auto closest_box_that_establishes_formatting_context = containing_block;
+            while (closest_box_that_establishes_formatting_context) {
+                if (closest_box_that_establishes_formatting_context == &viewport)
+                    break;
+                if (Layout::FormattingContext::formatting_context_type_created_by_box(*closest_box_that_establishes_formatting_context).has_value()) {
+                    break;
+                }
+                closest_box_that_establishes_formatting_context = closest_box_that_establishes_formatting_context->containing_block();
+            }
+            VERIFY(closest_box_that_establishes_formatting_context);
+            closest_box_that_establishes_formatting_context->add_contained_abspos_child(child);
+        }
+        return TraversalDecision::Continue;
+    });
+}
+
+static void relayout_in_place(Layout::BlockContainer& box)
+{
+    auto const& paintable_box = *box.paintable_box();
+    auto const& box_model = paintable_box.box_model();
+
+    Layout::LayoutState layout_state;
+
+    // The box keeps the geometry it was given by the last layout: its size doesn't depend on its contents, and its
+    // position is decided by ancestors that don't need layout.
+    auto& box_state = layout_state.get_mutable(box);
+    auto offset = paintable_box.offset();
+    if (box.computed_values().position() == CSS::Positioning::Relative)
+        offset.translate_by(-box_model.inset.left, -box_model.inset.top);
+    box_state.offset = offset;
+    box_state.set_content_width(paintable_box.content_width());
+    box_state.set_content_height(paintable_box.content_height());
+    box_state.inset_top = box_model.inset.top;
+    box_state.inset_right = box_model.inset.right;
+    box_state.inset_bottom = box_model.inset.bottom;
+    box_state.inset_left = box_model.inset.left;
+    box_state.padding_top = box_model.padding.top;
+    box_state.padding_right = box_model.padding.right;
+    box_state.padding_bottom = box_model.padding.bottom;
+    box_state.padding_left = box_model.padding.left;
+    box_state.border_top = box_model.border.top;
+    box_state.border_right = box_model.border.right;
+    box_state.border_bottom = box_model.border.bottom;
+    box_state.border_left = box_model.border.left;
+    box_state.margin_top = box_model.margin.top;
+    box_state.margin_right = box_model.margin.right;
+    box_state.margin_bottom = box_model.margin.bottom;
+    box_state.margin_left = box_model.margin.left;
+
+    {
+        Layout::BlockFormattingContext formatting_context(layout_state, Layout::LayoutMode::Normal, box, nullptr);
+        formatting_context.run(Layout::AvailableSpace(box_state.available_width_inside(), box_state.available_height_inside()));
+        formatting_context.parent_context_did_dimension_child_root_box();
+    }
+
+    layout_state.commit(box);
+}
+
+// If nothing but the contents of relayout boundaries changed since the last layout, lays out each of those boundaries
+// in place and leaves the rest of the layout and paintable trees untouched. Returns false if a full layout is needed.
+bool Document::try_to_relayout_boundaries_in_place()
+{
+    if (!paintable())
+        return false;
+    auto& viewport = *m_layout_root;
+
+    // NOTE: Ancestors of a node that needs layout are marked as well, so we only have to look along those paths.
+    Vector<GC::Ref<Layout::Box>> relayout_roots;
+    bool needs_full_layout = false;
+    viewport.for_each_in_inclusive_subtree([&](Layout::Node& node) {
+        if (!node.needs_layout_update())
+            return TraversalDecision::SkipChildrenAndContinue;
+        if (auto* box = as_if<Layout::Box>(node); box && !box->needs_own_layout_update() && box->is_relayout_boundary()) {
+            if (box->paintable_box() && box->paintable_box()->parent()) {
+                relayout_roots.append(*box);
+                return TraversalDecision::SkipChildrenAndContinue;
+            }
+        }
+        if (node.needs_own_layout_update()) {
+            needs_full_layout = true;
+            return TraversalDecision::Break;
+        }
+        return TraversalDecision::Continue;
+    });
+    if (needs_full_layout || relayout_roots.is_empty())
+        return false;
+
+    // Positioned descendants must not have escaped to a containing block outside of their relayout boundary.
+    for (auto& box : relayout_roots) {
+        bool has_escaping_descendant = false;
+        box->for_each_in_subtree([&](Layout::Node& descendant) {
+            descendant.recompute_containing_block({});
+            if (auto containing_block = descendant.containing_block(); !containing_block || !box->is_inclusive_ancestor_of(*containing_block)) {
+                has_escaping_descendant = true;
+                return TraversalDecision::Break;
+            }
+            return TraversalDecision::Continue;
+        });
+        if (has_escaping_descendant)
+            return false;
+    }
+
+    for (auto& box : relayout_roots) {
+        prepare_subtree_for_layout(*box, viewport);
+        relayout_in_place(as<Layout::BlockContainer>(*box));
+    }
+
+    // The paintables of the boundaries were replaced, so the stacking contexts referring to them must be rebuilt.
+    invalidate_stacking_context_tree();
+    ++m_in_place_relayout_count;
+
+    if constexpr (UPDATE_LAYOUT_DEBUG) {
+        dbgln("RELAYOUT {} boundaries in place", relayout_roots.size());
+    }
+
+    return true;
+}
+
 void Document::update_layout(UpdateLayoutReason reason)
 {
     auto navigable = this->navigable();
@@ -1311,6 +1447,7 @@ void Document::update_layout(UpdateLayoutReason reason)
 
     auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
 
+    bool did_rebuild_layout_tree = false;
     if (!m_layout_root || needs_layout_tree_update() || child_needs_layout_tree_update() || needs_full_layout_tree_update()) {
         Layout::TreeBuilder tree_builder;
         m_layout_root = as<Layout::Viewport>(*tree_builder.build(*this));
@@ -1321,71 +1458,47 @@ void Document::update_layout(UpdateLayoutReason reason)
         }
 
         set_needs_full_layout_tree_update(false);
+        did_rebuild_layout_tree = true;
 
         if constexpr (UPDATE_LAYOUT_DEBUG) {
             dbgln("TREEBUILD {} µs", timer.elapsed_time().to_microseconds());
         }
     }
 
-    m_layout_root->for_each_in_inclusive_subtree([&](auto& layout_node) {
-        layout_node.recompute_containing_block({});
-        return TraversalDecision::Continue;
-    });
+    if (did_rebuild_layout_tree || !try_to_relayout_boundaries_in_place()) {
+        u32 next_layout_index = 0;
+        m_layout_root->for_each_in_inclusive_subtree([&](auto& layout_node) {
+            layout_node.recompute_containing_block({});
+            layout_node.set_layout_index({}, next_layout_index++);
+            return TraversalDecision::Continue;
+        });
 
-    m_layout_root->for_each_in_inclusive_subtree_of_type<Layout::Box>([&](auto& child) {
-        if (auto dom_node = child.dom_node(); dom_node && dom_node->is_element()) {
-            child.set_has_size_containment(as<Element>(*dom_node).has_size_containment());
-        }
-        if (child.needs_layout_update()) {
-            child.reset_cached_intrinsic_sizes();
-        }
-        child.clear_contained_abspos_children();
-        return TraversalDecision::Continue;
-    });
+        prepare_subtree_for_layout(*m_layout_root, *m_layout_root);
 
-    // Assign each box that establishes a formatting context a list of absolutely positioned children it should take care of during layout
-    m_layout_root->for_each_in_inclusive_subtree_of_type<Layout::Box>([&](auto& child) {
-        if (!child.is_absolutely_positioned())
-            return TraversalDecision::Continue;
-        if (auto containing_block = child.containing_block()) {
-            auto closest_box_that_establishes_formatting_context = containing_block;
-            while (closest_box_that_establishes_formatting_context) {
-                if (closest_box_that_establishes_formatting_context == m_layout_root)
-                    break;
-                if (Layout::FormattingContext::formatting_context_type_created_by_box(*closest_box_that_establishes_formatting_context).has_value()) {
-                    break;
-                }
-                closest_box_that_establishes_formatting_context = closest_box_that_establishes_formatting_context->containing_block();
-            }
-            VERIFY(closest_box_that_establishes_formatting_context);
-            closest_box_that_establishes_formatting_context->add_contained_abspos_child(child);
-        }
-        return TraversalDecision::Continue;
-    });
+        Layout::LayoutState layout_state;
 
-    Layout::LayoutState layout_state;
+        {
+            Layout::BlockFormattingContext root_formatting_context(layout_state, Layout::LayoutMode::Normal, *m_layout_root, nullptr);
 
-    {
-        Layout::BlockFormattingContext root_formatting_context(layout_state, Layout::LayoutMode::Normal, *m_layout_root, nullptr);
+            auto& viewport = static_cast<Layout::Viewport&>(*m_layout_root);
+            auto& viewport_state = layout_state.get_mutable(viewport);
+            viewport_state.set_content_width(viewport_rect.width());
+            viewport_state.set_content_height(viewport_rect.height());
 
-        auto& viewport = static_cast<Layout::Viewport&>(*m_layout_root);
-        auto& viewport_state = layout_state.get_mutable(viewport);
-        viewport_state.set_content_width(viewport_rect.width());
-        viewport_state.set_content_height(viewport_rect.height());
+            if (document_element && document_element->layout_node()) {
+                auto& icb_state = layout_state.get_mutable(as<Layout::NodeWithStyleAndBoxModelMetrics>(*document_element->layout_node()));
+                icb_state.set_content_width(viewport_rect.width());
+            }
 
-        if (document_element && document_element->layout_node()) {
-            auto& icb_state = layout_state.get_mutable(as<Layout::NodeWithStyleAndBoxModelMetrics>(*document_element->layout_node()));
-            icb_state.set_content_width(viewport_rect.width());
+            root_formatting_context.run(
+                Layout::AvailableSpace(
+                    Layout::AvailableSize::make_definite(viewport_rect.width()),
+                    Layout::AvailableSize::make_definite(viewport_rect.height())));
         }
 
-        root_formatting_context.run(
-            Layout::AvailableSpace(
-                Layout::AvailableSize::make_definite(viewport_rect.width()),
-                Layout::AvailableSize::make_definite(viewport_rect.height())));
+        layout_state.commit(*m_layout_root);
     }
 
-    layout_state.commit(*m_layout_root);
-
     // Broadcast the current viewport rect to any new paintables, so they know whether they're visible or not.
     inform_all_viewport_clients_about_the_current_viewport_rect();
 
@@ -1488,6 +1601,20 @@ void Document::update_layout(UpdateLayoutReason reason)
     return invalidation;
 }
 
+// Collects the elements outside of shadow trees that update_style_recursively() is going to recompute, in tree order.
+static void collect_elements_needing_style_recompute(Node& node, bool needs_full_style_update, Vector<GC::Ref<Element>>& elements)
+{
+    if (auto* element = as_if<Element>(node); element && !element->is_shadow_host() && (needs_full_style_update || element->needs_style_update()))
+        elements.append(*element);
+
+    if (!needs_full_style_update && !node.child_needs_style_update())
+        return;
+    node.for_each_child([&](auto& child) {
+        collect_elements_needing_style_recompute(child, needs_full_style_update, elements);
+        return IterationDecision::Continue;
+    });
+}
+
 // This function makes a full pass over the entire DOM and converts "entire subtree needs style update"
 // into "needs style update" for each inclusive descendant where it's found.
 static void perform_pending_style_invalidations(Node& node, bool invalidate_entire_subtree)
@@ -1545,7 +1672,16 @@ void Document::update_style()
 
     style_computer().reset_ancestor_filter();
 
+    // Large style updates (like the initial one for a big document) get most of their selector matching done up front
+    // on multiple threads.
+    Vector<GC::Ref<Element>> elements_needing_style_recompute;
+    collect_elements_needing_style_recompute(*this, needs_full_style_update(), elements_needing_style_recompute);
+    style_computer().match_selectors_in_parallel({}, elements_needing_style_recompute);
+
+    style_computer().enable_style_sharing({});
     auto invalidation = update_style_recursively(*this, style_computer(), false);
+    style_computer().disable_style_sharing({});
+    style_computer().discard_parallel_selector_matches({});
     if (!invalidation.is_none())
         invalidate_display_list();
     if (invalidation.rebuild_stacking_context_tree)
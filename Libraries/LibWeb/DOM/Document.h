@@ -331,6 +331,7 @@ public:
 
     void update_style();
     void update_layout(UpdateLayoutReason);
+    u64 in_place_relayout_count() const { return m_in_place_relayout_count; }
     void update_paint_and_hit_testing_properties_if_needed();
     void update_animated_style_if_needed();
 
@@ -925,6 +926,8 @@ private:
 
     void tear_down_layout_tree();
 
+    [[nodiscard]] bool try_to_relayout_boundaries_in_place();
+
     void update_active_element();
 
     void run_unloading_cleanup_steps();
@@ -974,6 +977,9 @@ private:
 
     GC::Ptr<Layout::Viewport> m_layout_root;
 
+    // How many times update_layout() only laid out relayout boundaries, instead of running layout from the viewport.
+    u64 m_in_place_relayout_count { 0 };
+
     GC::Ptr<Node> m_hovered_node;
     GC::Ptr<Node> m_inspected_node;
     GC::Ptr<Node> m_highlighted_node;
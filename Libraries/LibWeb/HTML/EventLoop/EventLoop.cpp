@@ -52,6 +52,7 @@ void EventLoop::visit_edges(Visitor& visitor)
     visitor.visit(m_backup_incumbent_realm_stack);
     visitor.visit(m_rendering_task_function);
     visitor.visit(m_system_event_loop_timer);
+    visitor.visit(m_incremental_marking_timer);
 }
 
 void EventLoop::schedule()
@@ -66,6 +67,22 @@ void EventLoop::schedule()
         m_system_event_loop_timer->restart();
 }
 
+void EventLoop::schedule_incremental_marking_slice()
+{
+    // NOTE: Marking slices only run when the event loop is idle, so there's no point in coming back right away.
+    static constexpr int incremental_marking_slice_interval_ms = 16;
+
+    if (!m_incremental_marking_timer) {
+        m_incremental_marking_timer = Platform::Timer::create_single_shot(heap(), incremental_marking_slice_interval_ms, GC::create_function(heap(), [this] {
+            if (heap().is_incremental_marking_in_progress())
+                schedule();
+        }));
+    }
+
+    if (!m_incremental_marking_timer->is_active())
+        m_incremental_marking_timer->restart();
+}
+
 EventLoop& main_thread_event_loop()
 {
     return *static_cast<HTML::Agent*>(Bindings::main_thread_vm().agent())->event_loop;
@@ -214,11 +231,21 @@ void EventLoop::process()
         for (auto& win : same_loop_windows()) {
             win->start_an_idle_period();
         }
+
+        // OPTIMIZATION: Spend what's left of the idle period making progress on incremental garbage collection.
+        if (heap().is_incremental_marking_in_progress()) {
+            auto time_until_deadline = compute_deadline() - HighResolutionTime::unsafe_shared_current_time();
+            if (time_until_deadline > 0)
+                heap().perform_incremental_marking_slice(AK::Duration::from_microseconds(static_cast<i64>(time_until_deadline * 1000)));
+        }
     }
 
     // If there are eligible tasks in the queue, schedule a new round of processing. :^)
     if (m_task_queue->has_runnable_tasks() || (!m_microtask_queue->is_empty() && !m_performing_a_microtask_checkpoint)) {
         schedule();
+    } else if (m_type == Type::Window && heap().is_incremental_marking_in_progress()) {
+        // Keep coming back for more marking slices until the collection is finished.
+        schedule_incremental_marking_slice();
     }
 }
 
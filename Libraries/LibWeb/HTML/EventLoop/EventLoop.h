@@ -66,6 +66,7 @@ public:
     Task const* currently_running_task() const { return m_currently_running_task; }
 
     void schedule();
+    void schedule_incremental_marking_slice();
 
     void perform_a_microtask_checkpoint();
 
@@ -114,6 +115,7 @@ private:
     double m_last_idle_period_start_time { 0 };
 
     GC::Ptr<Platform::Timer> m_system_event_loop_timer;
+    GC::Ptr<Platform::Timer> m_incremental_marking_timer;
 
     // https://html.spec.whatwg.org/multipage/webappapis.html#performing-a-microtask-checkpoint
     bool m_performing_a_microtask_checkpoint { false };
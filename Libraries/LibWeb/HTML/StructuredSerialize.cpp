@@ -586,14 +586,14 @@ WebIDL::ExceptionOr<void> serialize_array_buffer(JS::VM& vm, Vector<u32>& vector
             //           [[ArrayBufferMaxByteLength]]: value.[[ArrayBufferMaxByteLength]],
             //           FIXME: [[AgentCluster]]: the surrounding agent's agent cluster }.
             serialize_enum(vector, ValueTag::GrowableSharedArrayBuffer);
-            TRY(serialize_bytes(vm, vector, array_buffer.buffer().bytes()));
+            TRY(serialize_bytes(vm, vector, array_buffer.bytes()));
             serialize_primitive_type(vector, array_buffer.max_byte_length());
         } else {
             // 4. Otherwise, set serialized to { [[Type]]: "SharedArrayBuffer", [[ArrayBufferData]]: value.[[ArrayBufferData]],
             //           [[ArrayBufferByteLength]]: value.[[ArrayBufferByteLength]],
             //           FIXME: [[AgentCluster]]: the surrounding agent's agent cluster }.
             serialize_enum(vector, ValueTag::SharedArrayBuffer);
-            TRY(serialize_bytes(vm, vector, array_buffer.buffer().bytes()));
+            TRY(serialize_bytes(vm, vector, array_buffer.bytes()));
         }
     }
 
@@ -1239,7 +1239,7 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
                 // 3. Set dataHolder.[[ArrayBufferByteLength]] to transferable.[[ArrayBufferByteLength]].
                 // 4. Set dataHolder.[[ArrayBufferMaxByteLength]] to transferable.[[ArrayBufferMaxByteLength]].
                 serialize_enum<TransferType>(data_holder.data, TransferType::ResizableArrayBuffer);
-                MUST(serialize_bytes(vm, data_holder.data, array_buffer->buffer().bytes())); // serializes both byte length and bytes
+                MUST(serialize_bytes(vm, data_holder.data, array_buffer->bytes())); // serializes both byte length and bytes
                 serialize_primitive_type<size_t>(data_holder.data, array_buffer->max_byte_length());
             }
 
@@ -1249,7 +1249,7 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
                 // 2. Set dataHolder.[[ArrayBufferData]] to transferable.[[ArrayBufferData]].
                 // 3. Set dataHolder.[[ArrayBufferByteLength]] to transferable.[[ArrayBufferByteLength]].
                 serialize_enum<TransferType>(data_holder.data, TransferType::ArrayBuffer);
-                MUST(serialize_bytes(vm, data_holder.data, array_buffer->buffer().bytes())); // serializes both byte length and bytes
+                MUST(serialize_bytes(vm, data_holder.data, array_buffer->bytes())); // serializes both byte length and bytes
             }
 
             // 3. Perform ? DetachArrayBuffer(transferable).
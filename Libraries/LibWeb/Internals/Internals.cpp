@@ -239,6 +239,11 @@ void Internals::set_browser_zoom(double factor)
     page().client().page_did_set_browser_zoom(factor);
 }
 
+WebIDL::UnsignedLongLong Internals::in_place_relayout_count()
+{
+    return window().associated_document().in_place_relayout_count();
+}
+
 bool Internals::headless()
 {
     return page().client().is_headless();
@@ -58,6 +58,8 @@ public:
 
     void set_browser_zoom(double factor);
 
+    WebIDL::UnsignedLongLong in_place_relayout_count();
+
     bool headless();
 
 private:
@@ -57,6 +57,45 @@ Optional<CSSPixelFraction> Box::natural_aspect_ratio() const
     return m_natural_aspect_ratio;
 }
 
+bool Box::is_relayout_boundary() const
+{
+    if (is_anonymous() || is_generated() || is_viewport() || is_list_item_box() || is_table_wrapper())
+        return false;
+
+    // NOTE: The contents are laid out again by a block formatting context rooted at this box.
+    if (!is<BlockContainer>(*this) || FormattingContext::formatting_context_type_created_by_box(*this) != FormattingContext::Type::Block)
+        return false;
+
+    auto const& computed_values = this->computed_values();
+
+    // Overflowing contents must not contribute to the scrollable overflow of any ancestor.
+    if (computed_values.overflow_x() == CSS::Overflow::Visible || computed_values.overflow_y() == CSS::Overflow::Visible)
+        return false;
+
+    // The size of the box must not depend on its contents.
+    if (!m_has_size_containment) {
+        if (!computed_values.width().is_length() || !computed_values.height().is_length())
+            return false;
+        if (!(computed_values.min_width().is_auto() || computed_values.min_width().is_length())
+            || !(computed_values.min_height().is_auto() || computed_values.min_height().is_length())
+            || !(computed_values.max_width().is_none() || computed_values.max_width().is_length())
+            || !(computed_values.max_height().is_none() || computed_values.max_height().is_length()))
+            return false;
+    }
+
+    // Nothing around the box may derive a baseline from its contents. Block-level boxes in block flow all the way up to
+    // the viewport guarantee that, while inline-blocks, table cells, flex and grid items would not.
+    for (auto const* node = static_cast<Node const*>(this); !node->is_viewport(); node = node->parent()) {
+        if (!node->display().is_block_outside())
+            return false;
+        auto parent_display = node->parent()->display();
+        if (!parent_display.is_flow_inside() && !parent_display.is_flow_root_inside())
+            return false;
+    }
+
+    return true;
+}
+
 void Box::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
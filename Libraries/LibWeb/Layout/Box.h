@@ -43,6 +43,11 @@ public:
     bool has_size_containment() const { return m_has_size_containment; }
     void set_has_size_containment(bool value) { m_has_size_containment = value; }
 
+    // A relayout boundary is a box whose size doesn't depend on its contents, and whose contents can't affect the layout
+    // of anything outside of it. When only its descendants have changed, it can be laid out again in place.
+    // NOTE: Positioned descendants may still escape the box; callers have to check their containing blocks.
+    bool is_relayout_boundary() const;
+
     void set_natural_width(Optional<CSSPixels> width) { m_natural_width = width; }
     void set_natural_height(Optional<CSSPixels> height) { m_natural_height = height; }
     void set_natural_aspect_ratio(Optional<CSSPixelFraction> ratio) { m_natural_aspect_ratio = ratio; }
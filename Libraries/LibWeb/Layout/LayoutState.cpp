@@ -22,32 +22,59 @@ LayoutState::~LayoutState()
 {
 }
 
-LayoutState::UsedValues& LayoutState::get_mutable(NodeWithStyle const& node)
+LayoutState::UsedValues* LayoutState::find_used_values(NodeWithStyle const& node) const
 {
-    if (auto* used_values = used_values_per_layout_node.get(node).value_or(nullptr))
-        return *used_values;
+    auto index = node.layout_index();
+    if (auto page_index = index / used_values_per_page; page_index < m_pages.size() && m_pages[page_index]) {
+        if (auto* used_values = (*m_pages[page_index])[index % used_values_per_page]; used_values && &used_values->node() == &node)
+            return used_values;
+    }
+    if (m_used_values_for_unindexed_nodes.is_empty())
+        return nullptr;
+    return m_used_values_for_unindexed_nodes.get(node).value_or(nullptr);
+}
 
+LayoutState::UsedValues& LayoutState::create_used_values(NodeWithStyle const& node)
+{
     auto const* containing_block_used_values = node.is_viewport() ? nullptr : &get(*node.containing_block());
 
-    auto new_used_values = adopt_own(*new UsedValues);
-    auto* new_used_values_ptr = new_used_values.ptr();
-    new_used_values->set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
-    used_values_per_layout_node.set(node, move(new_used_values));
-    return *new_used_values_ptr;
+    m_used_values.append({});
+    auto& used_values = m_used_values[m_used_values.size() - 1];
+    used_values.set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
+
+    if (auto index = node.layout_index(); index != Node::no_layout_index) {
+        auto page_index = index / used_values_per_page;
+        if (page_index >= m_pages.size())
+            m_pages.resize(page_index + 1);
+        if (!m_pages[page_index])
+            m_pages[page_index] = make<Page>();
+        if (auto& slot = (*m_pages[page_index])[index % used_values_per_page]; !slot) {
+            slot = &used_values;
+            return used_values;
+        }
+    }
+
+    m_used_values_for_unindexed_nodes.set(node, &used_values);
+    return used_values;
 }
 
-LayoutState::UsedValues const& LayoutState::get(NodeWithStyle const& node) const
+LayoutState::UsedValues& LayoutState::get_mutable(NodeWithStyle const& node)
 {
-    if (auto const* used_values = used_values_per_layout_node.get(node).value_or(nullptr))
+    if (auto* used_values = find_used_values(node))
         return *used_values;
+    return create_used_values(node);
+}
 
-    auto const* containing_block_used_values = node.is_viewport() ? nullptr : &get(*node.containing_block());
+LayoutState::UsedValues const& LayoutState::get(NodeWithStyle const& node) const
+{
+    if (auto const* used_values = find_used_values(node))
+        return *used_values;
+    return const_cast<LayoutState*>(this)->create_used_values(node);
+}
 
-    auto new_used_values = adopt_own(*new UsedValues);
-    auto* new_used_values_ptr = new_used_values.ptr();
-    new_used_values->set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
-    const_cast<LayoutState*>(this)->used_values_per_layout_node.set(node, move(new_used_values));
-    return *new_used_values_ptr;
+LayoutState::UsedValues const* LayoutState::try_get(NodeWithStyle const& node) const
+{
+    return find_used_values(node);
 }
 
 // https://www.w3.org/TR/css-overflow-3/#scrollable-overflow
@@ -138,12 +165,20 @@ static CSSPixelRect measure_scrollable_overflow(Box const& box)
     return scrollable_overflow_rect;
 }
 
-void LayoutState::resolve_relative_positions()
+// When a relayout boundary is laid out in place, the state also holds used values for the boxes between it and the
+// viewport. Those were only consulted during layout, so they must be left alone when committing.
+static bool is_within_committed_subtree(Box const& root, NodeWithStyle const& node)
+{
+    return root.is_viewport() || root.is_inclusive_ancestor_of(node);
+}
+
+void LayoutState::resolve_relative_positions(Box const& root)
 {
     // This function resolves relative position offsets of fragments that belong to inline paintables.
     // It runs *after* the paint tree has been constructed, so it modifies paintable node & fragment offsets directly.
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for (auto& used_values : m_used_values) {
+        if (!is_within_committed_subtree(root, used_values.node()))
+            continue;
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
         for (auto& paintable : node.paintables()) {
@@ -196,6 +231,7 @@ void LayoutState::commit(Box& root)
     // NOTE: In case this is a relayout of an existing tree, we start by detaching the old paint tree
     //       from the layout tree. This is done to ensure that we don't end up with any old-tree pointers
     //       when text paintables shift around in the tree.
+    GC::Ptr<Painting::Paintable> replaced_root_paintable = root.is_viewport() ? nullptr : root.first_paintable();
     root.for_each_in_inclusive_subtree([&](Layout::Node& node) {
         node.clear_paintables();
         return TraversalDecision::Continue;
@@ -203,7 +239,7 @@ void LayoutState::commit(Box& root)
 
     HashTable<Layout::InlineNode*> inline_nodes;
 
-    root.document().for_each_shadow_including_inclusive_descendant([&](DOM::Node& node) {
+    auto clear_paintable_and_collect_inline_nodes = [&](DOM::Node& node) {
         node.clear_paintable();
         if (node.layout_node() && is<InlineNode>(node.layout_node())) {
             // Inline nodes might have a continuation chain; add all inline nodes that are part of it.
@@ -213,8 +249,22 @@ void LayoutState::commit(Box& root)
                     inline_nodes.set(static_cast<InlineNode*>(inline_node.ptr()));
             }
         }
-        return TraversalDecision::Continue;
-    });
+    };
+
+    if (root.is_viewport()) {
+        root.document().for_each_shadow_including_inclusive_descendant([&](DOM::Node& node) {
+            clear_paintable_and_collect_inline_nodes(node);
+            return TraversalDecision::Continue;
+        });
+    } else {
+        // NOTE: The layout subtree of a relayout boundary is not necessarily made up of its DOM descendants, since slots
+        //       inside a shadow tree lay out the light DOM nodes assigned to them. So we go by the layout subtree here.
+        root.for_each_in_inclusive_subtree([&](Layout::Node& node) {
+            if (auto* dom_node = node.dom_node())
+                clear_paintable_and_collect_inline_nodes(*dom_node);
+            return TraversalDecision::Continue;
+        });
+    }
 
     HashTable<Layout::TextNode*> text_nodes;
     HashTable<Painting::PaintableWithLines*> inline_node_paintables;
@@ -232,7 +282,7 @@ void LayoutState::commit(Box& root)
                 auto& inline_node = const_cast<InlineNode&>(static_cast<InlineNode const&>(*parent));
                 auto line_paintable = inline_node.create_paintable_for_line_with_index(line_index);
                 line_paintable->add_fragment(fragment);
-                if (auto const* used_values = used_values_per_layout_node.get(inline_node).value_or(nullptr))
+                if (auto const* used_values = try_get(inline_node))
                     transfer_box_model_metrics(line_paintable->box_model(), *used_values);
                 if (!inline_node_paintables.contains(line_paintable.ptr())) {
                     inline_node_paintables.set(line_paintable.ptr());
@@ -244,8 +294,9 @@ void LayoutState::commit(Box& root)
         return false;
     };
 
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for (auto& used_values : m_used_values) {
+        if (!is_within_committed_subtree(root, used_values.node()))
+            continue;
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
         auto paintable = node.create_paintable();
@@ -306,18 +357,17 @@ void LayoutState::commit(Box& root)
         auto line_paintable = inline_node->create_paintable_for_line_with_index(0);
         inline_node->add_paintable(line_paintable);
         inline_node_paintables.set(line_paintable.ptr());
-        if (auto const* used_values = used_values_per_layout_node.get(*inline_node).value_or(nullptr))
+        if (auto const* used_values = try_get(*inline_node))
             transfer_box_model_metrics(line_paintable->box_model(), *used_values);
     }
 
     // Resolve relative positions for regular boxes (not line box fragments):
     // NOTE: This needs to occur before fragments are transferred into the corresponding inline paintables, because
     //       after this transfer, the containing_line_box_fragment will no longer be valid.
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for (auto& used_values : m_used_values) {
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
-        if (!node.is_box())
+        if (!node.is_box() || !is_within_committed_subtree(root, node))
             continue;
 
         auto& paintable = as<Painting::PaintableBox>(*node.first_paintable());
@@ -352,7 +402,10 @@ void LayoutState::commit(Box& root)
 
     build_paint_tree(root);
 
-    resolve_relative_positions();
+    if (replaced_root_paintable && replaced_root_paintable->parent())
+        replaced_root_paintable->parent()->replace_child(*root.first_paintable(), *replaced_root_paintable);
+
+    resolve_relative_positions(root);
 
     // Measure size of paintables created for inline nodes.
     for (auto& paintable_with_lines : inline_node_paintables) {
@@ -400,9 +453,8 @@ void LayoutState::commit(Box& root)
     }
 
     // Measure overflow in scroll containers.
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
-        if (!used_values.node().is_box())
+    for (auto& used_values : m_used_values) {
+        if (!used_values.node().is_box() || !is_within_committed_subtree(root, used_values.node()))
             continue;
         auto const& box = static_cast<Layout::Box const&>(used_values.node());
         measure_scrollable_overflow(box);
@@ -415,9 +467,10 @@ void LayoutState::commit(Box& root)
             paintable_box.set_scroll_offset(paintable_box.scroll_offset());
     }
 
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for (auto& used_values : m_used_values) {
         auto& node = used_values.node();
+        if (!is_within_committed_subtree(root, node))
+            continue;
         for (auto& paintable : node.paintables()) {
             Painting::PaintableBox* paintable_box = nullptr;
             if (is<Painting::PaintableBox>(paintable))
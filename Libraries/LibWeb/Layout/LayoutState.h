@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/HashMap.h>
+#include <AK/SegmentedVector.h>
 #include <LibGfx/Path.h>
 #include <LibGfx/Point.h>
 #include <LibWeb/Layout/Box.h>
@@ -200,15 +202,34 @@ struct LayoutState {
     ~LayoutState();
 
     // Commits the used values produced by layout and builds a paintable tree.
+    // If `root` isn't the viewport, it's a relayout boundary that was laid out in place, and only its subtree is
+    // committed. Its new paintable takes the place of the old one in the existing paintable tree.
     void commit(Box& root);
 
     UsedValues& get_mutable(NodeWithStyle const&);
     UsedValues const& get(NodeWithStyle const&) const;
 
-    HashMap<GC::Ref<Layout::Node const>, NonnullOwnPtr<UsedValues>> used_values_per_layout_node;
+    // Returns the used values of the node if they've already been created in this state.
+    UsedValues const* try_get(NodeWithStyle const&) const;
 
 private:
-    void resolve_relative_positions();
+    void resolve_relative_positions(Box const& root);
+
+    UsedValues* find_used_values(NodeWithStyle const&) const;
+    UsedValues& create_used_values(NodeWithStyle const&);
+
+    // Used values live in fixed-size segments, so they never move once created, and are found through a two-level
+    // table indexed by the layout index of their node. Pages of that table are only allocated once a node in their
+    // range is touched, which keeps the throwaway states used for intrinsic sizing cheap to create and destroy.
+    static constexpr size_t used_values_per_segment = 32;
+    static constexpr size_t used_values_per_page = 64;
+    using Page = Array<UsedValues*, used_values_per_page>;
+
+    SegmentedVector<UsedValues, used_values_per_segment> m_used_values;
+    Vector<OwnPtr<Page>> m_pages;
+
+    // Nodes created since the layout indices were assigned (or sharing a stale index with another node) are looked up here.
+    HashMap<GC::Ref<Layout::Node const>, UsedValues*> m_used_values_for_unindexed_nodes;
 };
 
 inline CSSPixels clamp_to_max_dimension_value(CSSPixels value)
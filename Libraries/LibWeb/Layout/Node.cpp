@@ -1283,7 +1283,7 @@ void NodeWithStyleAndBoxModelMetrics::visit_edges(Cell::Visitor& visitor)
 
 void Node::set_needs_layout_update(DOM::SetNeedsLayoutReason reason)
 {
-    if (m_needs_layout_update)
+    if (m_needs_own_layout_update)
         return;
 
     if constexpr (UPDATE_LAYOUT_DEBUG) {
@@ -1294,12 +1294,14 @@ void Node::set_needs_layout_update(DOM::SetNeedsLayoutReason reason)
     }
 
     m_needs_layout_update = true;
+    m_needs_own_layout_update = true;
 
     // Mark any anonymous children generated by this node for layout update.
     // NOTE: if this node generated an anonymous parent, all ancestors are indiscriminately marked below.
     for_each_child_of_type<Box>([&](Box& child) {
         if (child.is_anonymous() && !is<TableWrapper>(child)) {
             child.m_needs_layout_update = true;
+            child.m_needs_own_layout_update = true;
         }
         return IterationDecision::Continue;
     });
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/NonnullRefPtr.h>
+#include <AK/NumericLimits.h>
 #include <AK/Vector.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibWeb/CSS/StyleValues/ImageStyleValue.h>
@@ -47,7 +48,14 @@ public:
 
     bool needs_layout_update() const { return m_needs_layout_update; }
     void set_needs_layout_update(DOM::SetNeedsLayoutReason);
-    void reset_needs_layout_update() { m_needs_layout_update = false; }
+    void reset_needs_layout_update()
+    {
+        m_needs_layout_update = false;
+        m_needs_own_layout_update = false;
+    }
+
+    // True if this node itself changed, rather than only being marked on behalf of one of its descendants.
+    bool needs_own_layout_update() const { return m_needs_own_layout_update; }
 
     bool is_generated() const { return m_generated_for.has_value(); }
     bool is_generated_for_before_pseudo_element() const { return m_generated_for == CSS::GeneratedPseudoElement::Before; }
@@ -136,6 +144,12 @@ public:
 
     void recompute_containing_block(Badge<DOM::Document>);
 
+    // A dense index into the layout tree, assigned in tree order before every layout. LayoutState uses it to find the
+    // used values of a node without hashing. Nodes created since the last layout don't have one yet.
+    static constexpr u32 no_layout_index = NumericLimits<u32>::max();
+    u32 layout_index() const { return m_layout_index; }
+    void set_layout_index(Badge<DOM::Document>, u32 index) { m_layout_index = index; }
+
     [[nodiscard]] Box const* static_position_containing_block() const;
     [[nodiscard]] Box* static_position_containing_block() { return const_cast<Box*>(const_cast<Node const*>(this)->static_position_containing_block()); }
 
@@ -220,10 +234,12 @@ private:
     bool m_has_been_wrapped_in_table_wrapper { false };
 
     bool m_needs_layout_update { false };
+    bool m_needs_own_layout_update { false };
 
     Optional<CSS::GeneratedPseudoElement> m_generated_for {};
 
     u32 m_initial_quote_nesting_level { 0 };
+    u32 m_layout_index { no_layout_index };
 };
 
 class NodeWithStyle : public Node {
@@ -71,7 +71,8 @@ void Instance::initialize(JS::Realm& realm)
             [&](Wasm::MemoryAddress const& address) {
                 Optional<GC::Ptr<Memory>> object = m_memory_instances.get(address);
                 if (!object.has_value()) {
-                    object = realm.create<Memory>(realm, address, Memory::Shared::No);
+                    auto is_shared = cache.abstract_machine().store().get(address)->type().is_shared();
+                    object = realm.create<Memory>(realm, address, is_shared ? Memory::Shared::Yes : Memory::Shared::No);
                     m_memory_instances.set(address, *object);
                 }
 
@@ -17,6 +17,7 @@
 #include <LibJS/Runtime/Object.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/Runtime/ValueInlines.h>
+#include <LibWasm/AbstractMachine/ModuleCache.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWeb/Bindings/ResponsePrototype.h>
 #include <LibWeb/Fetch/Response.h>
@@ -48,6 +49,18 @@ WebAssemblyCache& get_cache(JS::Realm& realm)
     return s_caches.ensure(realm.global_object());
 }
 
+static Wasm::ModuleCache& module_cache()
+{
+    // NOTE: Compiled modules don't refer to anything realm-specific, so all realms in this process can share them.
+    static Wasm::ModuleCache s_module_cache { 64 * MiB };
+    return s_module_cache;
+}
+
+}
+
+void clear_module_cache()
+{
+    Detail::module_cache().clear();
 }
 
 void visit_edges(JS::Object& object, JS::Cell::Visitor& visitor)
@@ -384,6 +397,14 @@ JS::ThrowCompletionOr<NonnullOwnPtr<Wasm::ModuleInstance>> instantiate_module(JS
 // // https://webassembly.github.io/spec/js-api/#compile-a-webassembly-module
 JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webassembly_module(JS::VM& vm, ByteBuffer data)
 {
+    auto& cache = get_cache(*vm.current_realm());
+
+    if (auto module = module_cache().find(data.bytes())) {
+        auto compiled_module = make_ref_counted<CompiledWebAssemblyModule>(module.release_nonnull());
+        cache.add_compiled_module(compiled_module);
+        return compiled_module;
+    }
+
     FixedMemoryStream stream { data.bytes() };
     auto module_result = Wasm::Module::parse(stream);
     if (module_result.is_error()) {
@@ -391,11 +412,11 @@ JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webass
         return vm.throw_completion<JS::TypeError>(Wasm::parse_error_to_byte_string(module_result.error()));
     }
 
-    auto& cache = get_cache(*vm.current_realm());
     if (auto validation_result = cache.abstract_machine().validate(module_result.value()); validation_result.is_error()) {
         // FIXME: Throw CompileError instead.
         return vm.throw_completion<JS::TypeError>(validation_result.error().error_string);
     }
+    module_cache().add(data.bytes(), module_result.value());
     auto compiled_module = make_ref_counted<CompiledWebAssemblyModule>(module_result.release_value());
     cache.add_compiled_module(compiled_module);
     return compiled_module;
@@ -21,6 +21,9 @@ namespace Web::WebAssembly {
 void visit_edges(JS::Object&, JS::Cell::Visitor&);
 void finalize(JS::Object&);
 
+// Drops every compiled module that's only kept alive for reuse, e.g. to free up memory.
+void clear_module_cache();
+
 bool validate(JS::VM&, GC::Root<WebIDL::BufferSource>& bytes);
 WebIDL::ExceptionOr<GC::Ref<WebIDL::Promise>> compile(JS::VM&, GC::Root<WebIDL::BufferSource>& bytes);
 WebIDL::ExceptionOr<GC::Ref<WebIDL::Promise>> compile_streaming(JS::VM&, GC::Root<WebIDL::Promise> source);
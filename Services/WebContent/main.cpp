@@ -105,6 +105,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool force_cpu_painting = false;
     bool force_fontconfig = false;
     bool collect_garbage_on_every_allocation = false;
+    bool enable_generational_gc = false;
+    bool enable_incremental_gc = false;
+    Optional<u32> gc_slice_budget_ms;
     bool is_headless = false;
     bool disable_scrollbar_painting = false;
     StringView echo_server_port_string_view {};
@@ -127,6 +130,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(force_cpu_painting, "Force CPU painting", "force-cpu-painting");
     args_parser.add_option(force_fontconfig, "Force using fontconfig for font loading", "force-fontconfig");
     args_parser.add_option(collect_garbage_on_every_allocation, "Collect garbage after every JS heap allocation", "collect-garbage-on-every-allocation");
+    args_parser.add_option(enable_generational_gc, "Enable young generation garbage collections", "enable-generational-gc");
+    args_parser.add_option(enable_incremental_gc, "Enable incremental marking during idle periods", "enable-incremental-gc");
+    args_parser.add_option(gc_slice_budget_ms, "Maximum time to spend in one incremental marking slice, in milliseconds", "gc-slice-budget", 0, "ms");
     args_parser.add_option(disable_scrollbar_painting, "Don't paint horizontal or vertical viewport scrollbars", "disable-scrollbar-painting");
     args_parser.add_option(echo_server_port_string_view, "Echo server port used in test internals", "echo-server-port", 0, "echo_server_port");
     args_parser.add_option(is_headless, "Report that the browser is running in headless mode", "headless");
@@ -196,6 +202,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     if (collect_garbage_on_every_allocation)
         Web::Bindings::main_thread_vm().heap().set_should_collect_on_every_allocation(true);
 
+    if (enable_generational_gc)
+        Web::Bindings::main_thread_vm().heap().set_generational_collection_enabled(true);
+
+    if (enable_incremental_gc)
+        Web::Bindings::main_thread_vm().heap().set_incremental_marking_enabled(true);
+
+    if (gc_slice_budget_ms.has_value())
+        Web::Bindings::main_thread_vm().heap().set_incremental_marking_slice_budget(AK::Duration::from_milliseconds(*gc_slice_budget_ms));
+
     TRY(initialize_resource_loader(Web::Bindings::main_thread_vm().heap(), request_server_socket));
 
     if (log_all_js_exceptions) {
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/MappedFile.h>
+#include <LibGfx/Font/Font.h>
+#include <LibGfx/Font/Typeface.h>
+#include <LibGfx/TextLayout.h>
+#include <LibGfx/TextShapingCache.h>
+#include <LibTest/TestCase.h>
+
+#define TEST_INPUT(x) ("test-inputs/" x)
+
+static NonnullRefPtr<Gfx::Font> load_font(StringView path)
+{
+    auto file = MUST(Core::MappedFile::map(path));
+    auto typeface = MUST(Gfx::Typeface::try_load_from_temporary_memory(file->bytes()));
+    return typeface->font(16);
+}
+
+static void expect_same_glyph_runs(Gfx::GlyphRun const& a, Gfx::GlyphRun const& b)
+{
+    EXPECT_EQ(a.width(), b.width());
+    EXPECT_EQ(a.glyphs().size(), b.glyphs().size());
+    for (size_t i = 0; i < min(a.glyphs().size(), b.glyphs().size()); ++i) {
+        EXPECT_EQ(a.glyphs()[i].glyph_id, b.glyphs()[i].glyph_id);
+        EXPECT_EQ(a.glyphs()[i].position, b.glyphs()[i].position);
+    }
+}
+
+static void expect_same_shaping_as_harfbuzz(Gfx::Font const& font)
+{
+    Array texts = {
+        "AVATAR To Wo"sv,
+        "The quick brown fox jumps over the lazy dog."sv,
+        " !\"#$%&'()*+,-./0123456789:;<=>?@[\\]^_`{|}~"sv,
+        "A long line of text, long enough that its shaping results are never kept in a font's shaping cache."sv,
+    };
+    Array<Gfx::ShapeFeatures, 3> features_to_test = {
+        Gfx::ShapeFeatures {},
+        Gfx::ShapeFeatures { { { 'k', 'e', 'r', 'n' }, 0 } },
+        Gfx::ShapeFeatures { { { 'l', 'i', 'g', 'a' }, 0 }, { { 's', 'm', 'c', 'p' }, 1 } },
+    };
+
+    for (auto text : texts) {
+        for (auto const& features : features_to_test) {
+            for (auto letter_spacing : { 0.0f, 2.5f }) {
+                auto expected = Gfx::shape_text_with_harfbuzz({ 10, 20 }, letter_spacing, Utf8View { text }, font, Gfx::GlyphRun::TextType::Ltr, features);
+
+                // Shaping twice also compares against what the first call left in the font's shaping cache.
+                for (size_t i = 0; i < 2; ++i) {
+                    auto shaped = Gfx::shape_text({ 10, 20 }, letter_spacing, Utf8View { text }, font, Gfx::GlyphRun::TextType::Ltr, features);
+                    expect_same_glyph_runs(*shaped, *expected);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE(ascii_in_font_without_shaping_tables)
+{
+    auto font = load_font(TEST_INPUT("ttf/SerenitySans-Regular.ttf"sv));
+    EXPECT(font->printable_ascii_glyphs_for_simple_shaping());
+    expect_same_shaping_as_harfbuzz(*font);
+}
+
+TEST_CASE(ascii_in_kerned_font)
+{
+    auto font = load_font(TEST_INPUT("ttf/SerenitySans-Kerned.ttf"sv));
+    EXPECT(!font->printable_ascii_glyphs_for_simple_shaping());
+    expect_same_shaping_as_harfbuzz(*font);
+
+    // This font kerns "AV", so shaping it has to take more than each glyph's own advance into account.
+    auto pair_width = Gfx::measure_text_width(Utf8View { "AV"sv }, *font, {});
+    auto separate_width = Gfx::measure_text_width(Utf8View { "A"sv }, *font, {}) + Gfx::measure_text_width(Utf8View { "V"sv }, *font, {});
+    EXPECT(pair_width < separate_width);
+
+    Gfx::ShapeFeatures without_kerning { { { 'k', 'e', 'r', 'n' }, 0 } };
+    EXPECT_EQ(Gfx::measure_text_width(Utf8View { "AV"sv }, *font, without_kerning), separate_width);
+}
+
+TEST_CASE(shaping_cache_is_bounded)
+{
+    auto font = load_font(TEST_INPUT("ttf/SerenitySans-Kerned.ttf"sv));
+    for (size_t i = 0; i < Gfx::TextShapingCache::max_entry_count * 2; ++i) {
+        auto text = ByteString::number(i);
+        (void)Gfx::measure_text_width(Utf8View { text }, *font, {});
+    }
+    EXPECT_EQ(font->shaping_cache().size(), Gfx::TextShapingCache::max_entry_count);
+
+    // The most recently shaped strings are the ones that are kept.
+    auto last_text = ByteString::number(Gfx::TextShapingCache::max_entry_count * 2 - 1);
+    EXPECT(font->shaping_cache().get(last_text, {}));
+    EXPECT(!font->shaping_cache().get("0"sv, {}));
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Runtime/ArrayBuffer.h>
+#include <LibTest/TestCase.h>
+
+TEST_CASE(owned_block_bytes_cover_the_whole_buffer)
+{
+    JS::DataBlock block { MUST(ByteBuffer::create_zeroed(16)), JS::DataBlock::Shared::No };
+    EXPECT_EQ(block.size(), 16u);
+    EXPECT_EQ(block.bytes().size(), 16u);
+}
+
+TEST_CASE(fixed_size_block_bytes_ignore_growth)
+{
+    auto storage = MUST(ByteBuffer::create_zeroed(16));
+    storage[0] = 42;
+    JS::DataBlock block { &storage, JS::DataBlock::Shared::Yes, storage.size() };
+
+    // Growing the borrowed storage (e.g. memory.grow()) must not change what the block exposes.
+    MUST(storage.try_resize(64));
+    EXPECT_EQ(block.size(), 16u);
+    EXPECT_EQ(block.bytes().size(), 16u);
+    EXPECT_EQ(block.bytes().data(), storage.data());
+    EXPECT_EQ(block.bytes()[0], 42);
+    EXPECT_EQ(block.buffer().size(), 64u);
+}
+
+TEST_CASE(borrowed_block_without_fixed_size_follows_growth)
+{
+    auto storage = MUST(ByteBuffer::create_zeroed(16));
+    JS::DataBlock block { &storage, JS::DataBlock::Shared::No };
+
+    MUST(storage.try_resize(64));
+    EXPECT_EQ(block.size(), 64u);
+    EXPECT_EQ(block.bytes().size(), 64u);
+}
@@ -417,10 +417,10 @@ TEST_CASE(named_capture_group)
     EXPECT_EQ(result.count, 2u);
     EXPECT_EQ(result.matches.at(0).view, "Opacity=255");
     EXPECT_EQ(result.capture_group_matches.at(0).at(0).view, "255");
-    EXPECT_EQ(re.parser_result.bytecode.get_string(result.capture_group_matches.at(0).at(0).capture_group_name), "Test");
+    EXPECT_EQ(re.parser_result->bytecode.get_string(result.capture_group_matches.at(0).at(0).capture_group_name), "Test");
     EXPECT_EQ(result.matches.at(1).view, "AudibleBeep=0");
     EXPECT_EQ(result.capture_group_matches.at(1).at(0).view, "0");
-    EXPECT_EQ(re.parser_result.bytecode.get_string(result.capture_group_matches.at(1).at(0).capture_group_name), "Test");
+    EXPECT_EQ(re.parser_result->bytecode.get_string(result.capture_group_matches.at(1).at(0).capture_group_name), "Test");
 }
 
 TEST_CASE(ecma262_named_capture_group_with_dollar_sign)
@@ -440,10 +440,10 @@ TEST_CASE(ecma262_named_capture_group_with_dollar_sign)
     EXPECT_EQ(result.count, 2u);
     EXPECT_EQ(result.matches.at(0).view, "Opacity=255");
     EXPECT_EQ(result.capture_group_matches.at(0).at(0).view, "255");
-    EXPECT_EQ(re.parser_result.bytecode.get_string(result.capture_group_matches.at(0).at(0).capture_group_name), "$Test$");
+    EXPECT_EQ(re.parser_result->bytecode.get_string(result.capture_group_matches.at(0).at(0).capture_group_name), "$Test$");
     EXPECT_EQ(result.matches.at(1).view, "AudibleBeep=0");
     EXPECT_EQ(result.capture_group_matches.at(1).at(0).view, "0");
-    EXPECT_EQ(re.parser_result.bytecode.get_string(result.capture_group_matches.at(1).at(0).capture_group_name), "$Test$");
+    EXPECT_EQ(re.parser_result->bytecode.get_string(result.capture_group_matches.at(1).at(0).capture_group_name), "$Test$");
 }
 
 TEST_CASE(a_star)
@@ -605,7 +605,7 @@ TEST_CASE(ECMA262_parse)
 
     for (auto& test : tests) {
         Regex<ECMA262> re(test.pattern, test.flags);
-        EXPECT_EQ(re.parser_result.error, test.expected_error);
+        EXPECT_EQ(re.parser_result->error, test.expected_error);
         if constexpr (REGEX_DEBUG) {
             dbgln("\n");
             RegexDebug regex_dbg(stderr);
@@ -748,7 +748,7 @@ TEST_CASE(ECMA262_match)
             regex_dbg.print_bytecode(re);
             dbgln("\n");
         }
-        EXPECT_EQ(re.parser_result.error, regex::Error::NoError);
+        EXPECT_EQ(re.parser_result->error, regex::Error::NoError);
         EXPECT_EQ(re.match(test.subject).success, test.matches);
     }
 }
@@ -816,7 +816,7 @@ TEST_CASE(ECMA262_unicode_match)
             dbgln("\n");
         }
 
-        EXPECT_EQ(re.parser_result.error, regex::Error::NoError);
+        EXPECT_EQ(re.parser_result->error, regex::Error::NoError);
         EXPECT_EQ(re.match(view).success, test.matches);
     }
 }
@@ -835,7 +835,7 @@ TEST_CASE(ECMA262_unicode_sets_parser_error)
 
     for (auto test : tests) {
         Regex<ECMA262> re(test.pattern, (ECMAScriptFlags)regex::AllFlags::UnicodeSets);
-        EXPECT_EQ(re.parser_result.error, test.error);
+        EXPECT_EQ(re.parser_result->error, test.error);
     }
 }
 
@@ -872,7 +872,7 @@ TEST_CASE(ECMA262_unicode_sets_match)
             dbgln("\n");
         }
 
-        EXPECT_EQ(re.parser_result.error, regex::Error::NoError);
+        EXPECT_EQ(re.parser_result->error, regex::Error::NoError);
         auto result = re.match(test.subject).success;
         EXPECT_EQ(result, test.matches);
     }
@@ -948,7 +948,7 @@ TEST_CASE(ECMA262_property_match)
             dbgln("\n");
         }
 
-        EXPECT_EQ(re.parser_result.error, regex::Error::NoError);
+        EXPECT_EQ(re.parser_result->error, regex::Error::NoError);
         EXPECT_EQ(re.match(view).success, test.matches);
     }
 }
@@ -981,7 +981,7 @@ TEST_CASE(replace)
             regex_dbg.print_bytecode(re);
             dbgln("\n");
         }
-        EXPECT_EQ(re.parser_result.error, regex::Error::NoError);
+        EXPECT_EQ(re.parser_result->error, regex::Error::NoError);
         EXPECT_EQ(re.replace(test.subject, test.replacement), test.expected);
     }
 }
@@ -1284,7 +1284,7 @@ TEST_CASE(mismatching_brackets)
 
     for (auto const& test_case : test_cases) {
         Regex<ECMA262> re(test_case);
-        EXPECT_EQ(re.parser_result.error, regex::Error::MismatchingBracket);
+        EXPECT_EQ(re.parser_result->error, regex::Error::MismatchingBracket);
     }
 }
 
@@ -1296,3 +1296,176 @@ TEST_CASE(optimizer_repeat_offset)
         Regex<ECMA262> re("\\/?\\??#?([\\/?#]|[\\uD800-\\uDBFF]|%[c-f][0-9a-f](%[89ab][0-9a-f]){0,2}(%[89ab]?)?|%[0-9a-f]?)$"sv);
     }
 }
+
+TEST_CASE(lazy_dfa_search)
+{
+    // After failing to match at the first position, the matcher uses a lazy DFA to skip impossible start positions on long inputs.
+    StringBuilder builder;
+    for (size_t i = 0; i < 1000; ++i)
+        builder.append("ab"sv);
+    auto no_match = builder.to_byte_string();
+    auto with_matches = ByteString::formatted("--{}c--abbc", no_match);
+
+    {
+        Regex<ECMA262> re("(a|b)*c"sv, ECMAScriptFlags::Global);
+        auto result = re.match(no_match.view());
+        EXPECT_EQ(result.success, false);
+
+        result = re.match(with_matches.view());
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.size(), 2u);
+        EXPECT_EQ(result.matches[0].global_offset, 2u);
+        EXPECT_EQ(result.matches[0].view.length(), 2001u);
+        EXPECT_EQ(result.matches[1].global_offset, 2005u);
+        EXPECT_EQ(result.matches[1].view.to_byte_string(), "abbc"sv);
+        EXPECT_EQ(result.capture_group_matches[1][0].view.to_byte_string(), "b"sv);
+    }
+    {
+        Regex<ECMA262> re("-+A(b|x)B"sv, ECMAScriptFlags::Global | ECMAScriptFlags::Insensitive);
+        auto result = re.match(with_matches.view());
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.size(), 1u);
+        EXPECT_EQ(result.matches[0].global_offset, 2003u);
+        EXPECT_EQ(result.matches[0].view.to_byte_string(), "--abb"sv);
+    }
+    {
+        Regex<ECMA262> re("--ABBC"sv, ECMAScriptFlags::Global | ECMAScriptFlags::Insensitive);
+        auto result = re.match(with_matches.view());
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.size(), 1u);
+        EXPECT_EQ(result.matches[0].global_offset, 2003u);
+    }
+    {
+        // Assertions are looked through by the DFA, but still have to be checked by the matcher.
+        Regex<ECMA262> re("\\bab|c$"sv, ECMAScriptFlags::Global);
+        auto result = re.match(with_matches.view());
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.size(), 3u);
+        EXPECT_EQ(result.matches[0].global_offset, 2u);
+        EXPECT_EQ(result.matches[1].global_offset, 2005u);
+        EXPECT_EQ(result.matches[2].global_offset, 2008u);
+    }
+    {
+        // Lookarounds aren't supported by the DFA, so these keep using the backtracker alone.
+        Regex<ECMA262> re("b(?=c)"sv, ECMAScriptFlags::Global);
+        auto result = re.match(with_matches.view());
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.size(), 2u);
+    }
+}
+
+TEST_CASE(lazy_dfa_search_reused_for_same_input)
+{
+    // A global exec() loop searches the same input again and again from where the last match ended.
+    StringBuilder builder;
+    for (size_t i = 0; i < 10; ++i) {
+        builder.append_repeated('x', 300);
+        builder.appendff("a{}c", i);
+    }
+    auto input = builder.to_byte_string();
+
+    Regex<ECMA262> re("a\\dc"sv, ECMAScriptFlags::Global | (ECMAScriptFlags)regex::AllFlags::SingleMatch);
+    Vector<size_t> offsets;
+    for (;;) {
+        auto result = re.match(input.view());
+        if (!result.success)
+            break;
+        offsets.append(result.matches[0].global_offset);
+        re.input_unchanged_since_last_match = true;
+    }
+    EXPECT_EQ(offsets.size(), 10u);
+    for (size_t i = 0; i < offsets.size(); ++i)
+        EXPECT_EQ(offsets[i], 300 + i * 303);
+
+    // Without the caller's promise, a different input is searched on its own terms.
+    auto other_input = ByteString::formatted("{}a9c", ByteString::repeated('x', input.length() - 3));
+    re.start_offset = 0;
+    auto result = re.match(other_input.view());
+    EXPECT_EQ(result.success, true);
+    EXPECT_EQ(result.matches[0].global_offset, input.length() - 3);
+}
+
+TEST_CASE(literal_prefilter)
+{
+    {
+        Regex<ECMA262> re("foo\\d+"sv, ECMAScriptFlags::Global);
+        EXPECT_EQ(re.parser_result->optimization_data.starting_literal, "foo"sv);
+
+        auto result = re.match("xx foo fooo foo12 xfoo3"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.size(), 2u);
+        EXPECT_EQ(result.matches[0].view.to_byte_string(), "foo12"sv);
+        EXPECT_EQ(result.matches[1].view.to_byte_string(), "foo3"sv);
+    }
+    {
+        // The literal is required, but may be preceded by anything.
+        Regex<ECMA262> re("[a-z]+@example\\.com"sv, ECMAScriptFlags::Global);
+        EXPECT_EQ(re.parser_result->optimization_data.starting_literal.has_value(), false);
+        EXPECT_EQ(re.parser_result->optimization_data.required_literal, "@example.com"sv);
+
+        auto result = re.match("mail joe@example.com or ann@example.org, not @example.com"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.size(), 1u);
+        EXPECT_EQ(result.matches[0].view.to_byte_string(), "joe@example.com"sv);
+    }
+    {
+        // Optional and alternative literals aren't required.
+        Regex<ECMA262> re("a(bc)?d|e"sv);
+        EXPECT_EQ(re.parser_result->optimization_data.starting_literal.has_value(), false);
+        EXPECT_EQ(re.parser_result->optimization_data.required_literal.has_value(), false);
+    }
+    {
+        // Lookbehinds can match before the start of a match.
+        Regex<ECMA262> re("(?<=ab)c"sv, ECMAScriptFlags::Global);
+        EXPECT_EQ(re.parser_result->optimization_data.required_literal.has_value(), false);
+        EXPECT_EQ(re.match("xabcabc"sv).matches.size(), 2u);
+    }
+    {
+        Regex<ECMA262> re("\\w+"sv, ECMAScriptFlags::Global);
+        EXPECT_EQ(re.parser_result->optimization_data.starting_ranges.size(), 4u);
+
+        auto result = re.match("  ...  hello, wide_world! "sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.size(), 2u);
+        EXPECT_EQ(result.matches[0].view.to_byte_string(), "hello"sv);
+        EXPECT_EQ(result.matches[1].view.to_byte_string(), "wide_world"sv);
+    }
+    {
+        Regex<ECMA262> re("\\s\\d"sv, ECMAScriptFlags::Global);
+        auto subject = MUST(AK::utf8_to_utf16("a1 2 3 4"sv));
+        auto result = re.match(Utf16View { subject });
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.size(), 3u);
+    }
+    {
+        // The prefilters compare code units exactly, so case-insensitive searches don't use them.
+        Regex<ECMA262> re("Hello"sv, ECMAScriptFlags::Global | ECMAScriptFlags::Insensitive);
+        EXPECT_EQ(re.match("say hello, HELLO"sv).matches.size(), 2u);
+    }
+    {
+        // Sticky searches don't skip ahead to the next occurrence.
+        Regex<ECMA262> re("bar"sv, ECMAScriptFlags::Sticky);
+        EXPECT_EQ(re.match("foobar"sv).success, false);
+        EXPECT_EQ(re.match("barfoo"sv).success, true);
+    }
+}
+
+TEST_CASE(parse_result_cache)
+{
+    // Regexes built from an existing parse result share the optimized program with ones built from the pattern.
+    auto parse_result = Regex<ECMA262>::parse_pattern("(a+)b"sv, ECMAScriptFlags::Global);
+    Regex<ECMA262> from_parse_result(parse_result, "(a+)b", ECMAScriptFlags::Global);
+    Regex<ECMA262> from_pattern("(a+)b", ECMAScriptFlags::Global);
+    Regex<ECMA262> insensitive("(a+)b", ECMAScriptFlags::Global | ECMAScriptFlags::Insensitive);
+
+    EXPECT_EQ(from_parse_result.parser_result->error, regex::Error::NoError);
+    EXPECT_EQ(from_parse_result.parser_result->bytecode.size(), from_pattern.parser_result->bytecode.size());
+    EXPECT_EQ(from_parse_result.parser_result->capture_groups_count, 1u);
+
+    for (auto* re : { &from_parse_result, &from_pattern }) {
+        auto result = re->match("xaab ab AB"sv);
+        EXPECT_EQ(result.matches.size(), 2u);
+        EXPECT_EQ(result.capture_group_matches[0][0].view.to_byte_string(), "aa"sv);
+    }
+    EXPECT_EQ(insensitive.match("xaab ab AB"sv).matches.size(), 3u);
+}
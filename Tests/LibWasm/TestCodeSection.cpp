@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/Parallel.h>
+#include <LibWasm/Types.h>
+
+static void append_leb128(Vector<u8>& bytes, u32 value)
+{
+    do {
+        u8 byte = value & 0x7f;
+        value >>= 7;
+        if (value != 0)
+            byte |= 0x80;
+        bytes.append(byte);
+    } while (value != 0);
+}
+
+// A module with only a code section, whose contents are `code_section`.
+static Vector<u8> module_binary(ReadonlyBytes code_section)
+{
+    Vector<u8> bytes { 0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x0a };
+    append_leb128(bytes, code_section.size());
+    bytes.append(code_section.data(), code_section.size());
+    return bytes;
+}
+
+// A function body of `size` bytes whose only local has an invalid type.
+static void append_invalid_body(Vector<u8>& code_section, u32 size)
+{
+    append_leb128(code_section, size);
+    code_section.append(0x01);
+    code_section.append(0x01);
+    code_section.append(0x00);
+    for (size_t i = 3; i < size; ++i)
+        code_section.append(0x00);
+}
+
+// A function body of `size` bytes with no locals, which does nothing.
+static void append_valid_body(Vector<u8>& code_section, u32 size)
+{
+    append_leb128(code_section, size);
+    code_section.append(0x00);
+    for (size_t i = 2; i < size; ++i)
+        code_section.append(0x01);
+    code_section.append(0x0b);
+}
+
+static Wasm::ParseError parse_error(ReadonlyBytes binary)
+{
+    FixedMemoryStream stream { binary };
+    auto result = Wasm::Module::parse(stream);
+    VERIFY(result.is_error());
+    return result.error();
+}
+
+TEST_CASE(invalid_body_before_invalid_size_prefix)
+{
+    for (u32 body_size : { 16u, static_cast<u32>(Wasm::minimum_code_size_for_parallel_compilation) }) {
+        Vector<u8> code_section;
+        append_leb128(code_section, 2);
+        append_invalid_body(code_section, body_size);
+        // The second body claims to be bigger than what's left of the section.
+        append_leb128(code_section, 1);
+
+        EXPECT(parse_error(module_binary(code_section)) == Wasm::ParseError::InvalidTag);
+    }
+}
+
+TEST_CASE(invalid_size_prefix_after_valid_bodies)
+{
+    Vector<u8> code_section;
+    append_leb128(code_section, 3);
+    append_valid_body(code_section, Wasm::minimum_code_size_for_parallel_compilation / 2);
+    append_valid_body(code_section, Wasm::minimum_code_size_for_parallel_compilation / 2);
+    append_leb128(code_section, 1);
+
+    EXPECT(parse_error(module_binary(code_section)) == Wasm::ParseError::UnexpectedEof);
+}
+
+TEST_CASE(invalid_body_before_trailing_bytes)
+{
+    Vector<u8> code_section;
+    append_leb128(code_section, 1);
+    append_invalid_body(code_section, Wasm::minimum_code_size_for_parallel_compilation);
+    code_section.append(0x00);
+
+    EXPECT(parse_error(module_binary(code_section)) == Wasm::ParseError::InvalidTag);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/ModuleCache.h>
+#include <LibWasm/AbstractMachine/Validator.h>
+
+// An empty module with a single custom section named "a", whose one byte of contents is `tag`.
+static Array<u8, 13> module_binary(u8 tag)
+{
+    return { 0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0x61, tag };
+}
+
+static NonnullRefPtr<Wasm::Module> compile(ReadonlyBytes binary)
+{
+    FixedMemoryStream stream { binary };
+    auto module = MUST(Wasm::Module::parse(stream));
+    Wasm::AbstractMachine machine;
+    MUST(machine.validate(*module));
+    return module;
+}
+
+TEST_CASE(identical_binaries_hit)
+{
+    Wasm::ModuleCache cache { 1 * MiB };
+    auto binary = module_binary(1);
+    auto module = compile(binary);
+
+    EXPECT(!cache.find(binary));
+    cache.add(binary, module);
+
+    auto same_bytes = module_binary(1);
+    EXPECT_EQ(cache.find(same_bytes).ptr(), module.ptr());
+}
+
+TEST_CASE(different_binaries_miss)
+{
+    Wasm::ModuleCache cache { 1 * MiB };
+    auto binary = module_binary(1);
+    auto module = compile(binary);
+    cache.add(binary, module);
+
+    // Same length, different last byte.
+    auto other_binary = module_binary(2);
+    EXPECT(!cache.find(other_binary));
+    EXPECT(!cache.find(binary.span().trim(binary.size() - 1)));
+
+    auto other_module = compile(other_binary);
+    cache.add(other_binary, other_module);
+    EXPECT_EQ(cache.find(binary).ptr(), module.ptr());
+    EXPECT_EQ(cache.find(other_binary).ptr(), other_module.ptr());
+}
+
+TEST_CASE(size_includes_the_parsed_module)
+{
+    auto binary = module_binary(1);
+    auto module = compile(binary);
+
+    Wasm::ModuleCache cache { 1 * MiB };
+    cache.add(binary, module);
+    EXPECT(cache.size_in_bytes() > binary.size());
+
+    // The binary alone would fit, but the module it was parsed into doesn't.
+    Wasm::ModuleCache small_cache { binary.size() };
+    small_cache.add(binary, module);
+    EXPECT(!small_cache.find(binary));
+    EXPECT_EQ(small_cache.size_in_bytes(), 0u);
+}
+
+TEST_CASE(least_recently_used_entries_are_evicted)
+{
+    auto first_binary = module_binary(1);
+    auto second_binary = module_binary(2);
+    auto third_binary = module_binary(3);
+
+    Wasm::ModuleCache measuring_cache { 1 * MiB };
+    measuring_cache.add(first_binary, compile(first_binary));
+    auto entry_size = measuring_cache.size_in_bytes();
+
+    Wasm::ModuleCache cache { entry_size * 2 };
+    cache.add(first_binary, compile(first_binary));
+    cache.add(second_binary, compile(second_binary));
+    EXPECT(cache.find(first_binary));
+
+    cache.add(third_binary, compile(third_binary));
+    EXPECT(cache.find(first_binary));
+    EXPECT(!cache.find(second_binary));
+    EXPECT(cache.find(third_binary));
+}
+
+TEST_CASE(clear)
+{
+    Wasm::ModuleCache cache { 1 * MiB };
+    auto binary = module_binary(1);
+    cache.add(binary, compile(binary));
+
+    cache.clear();
+    EXPECT(!cache.find(binary));
+    EXPECT_EQ(cache.size_in_bytes(), 0u);
+}
@@ -13,6 +13,8 @@
 
 TEST_ROOT("Libraries/LibWasm/Tests");
 
+TESTJS_PROGRAM_FLAG(use_switch_dispatch, "Run Wasm with switch-based instead of threaded dispatch", "switch-dispatch", 0);
+
 TESTJS_GLOBAL_FUNCTION(read_binary_wasm_file, readBinaryWasmFile)
 {
     auto& realm = *vm.current_realm();
@@ -48,6 +50,8 @@ public:
         : JS::Object(ConstructWithPrototypeTag::Tag, prototype)
     {
         m_machine.enable_instruction_count_limit();
+        if (use_switch_dispatch)
+            m_machine.set_dispatch_mode(Wasm::DispatchMode::Switch);
     }
 
     static Wasm::AbstractMachine& machine() { return m_machine; }
@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <AK/JsonValue.h>
 #include <AK/NeverDestroyed.h>
 #include <AK/StringBuilder.h>
@@ -541,6 +542,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.set_general_help("This is a JavaScript interpreter.");
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    if constexpr (JS_BYTECODE_DEBUG)
+        args_parser.add_option(JS::Bytecode::g_dump_property_lookup_cache_statistics, "Dump property lookup cache hit rates when exiting", "dump-property-lookup-cache-statistics", {});
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
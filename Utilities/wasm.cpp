@@ -529,6 +529,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     Vector<ByteString> modules_to_link_in;
     Vector<StringView> args_if_wasi;
     Vector<StringView> wasi_preopened_mappings;
+    auto dispatch_mode = Wasm::DispatchMode::Threaded;
 
     Core::ArgsParser parser;
     parser.add_positional_argument(filename, "File name to parse", "file");
@@ -583,6 +584,24 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             return true;
         },
     });
+    parser.add_option(Core::ArgsParser::Option {
+        .argument_mode = Core::ArgsParser::OptionArgumentMode::Required,
+        .help_string = "How the interpreter dispatches instructions, for comparing their performance (threaded or switch)",
+        .long_name = "dispatch",
+        .short_name = 0,
+        .value_name = "mode",
+        .accept_value = [&](StringView str) {
+            if (str == "threaded"sv) {
+                dispatch_mode = Wasm::DispatchMode::Threaded;
+                return true;
+            }
+            if (str == "switch"sv) {
+                dispatch_mode = Wasm::DispatchMode::Switch;
+                return true;
+            }
+            return false;
+        },
+    });
     parser.add_positional_argument(args_if_wasi, "Arguments to pass to the WASI module", "args", Core::ArgsParser::Required::No);
     parser.parse(arguments);
 
@@ -603,6 +622,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     if (!exported_function_to_execute.is_empty())
         attempt_instantiate = true;
 
+    g_interpreter.set_dispatch_mode(dispatch_mode);
+
     auto parse_result = parse(filename);
     if (parse_result.is_null())
         return 1;
@@ -617,6 +638,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     if (attempt_instantiate) {
         Wasm::AbstractMachine machine;
+        machine.set_dispatch_mode(dispatch_mode);
         Optional<Wasm::Wasi::Implementation> wasi_impl;
 
         if (wasi) {